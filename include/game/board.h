@@ -4,14 +4,36 @@
 #include "grid/grid_geometry.h"
 #include "tile/tile_map.h"
 #include "tile/pool_manager.h"
+#include "tile/tile_store.h"
 #include "utility/array_shuffle.h"
+#include "utility/bitboard.h"
+#include "utility/slab.h"
 #include "raylib.h"
 
+typedef struct board_traversal board_traversal_t; /* See board_traversal.h */
+
 typedef enum {
     BOARD_TYPE_MAIN,        /* Main game board with center tile */
     BOARD_TYPE_INVENTORY    /* Inventory piece without center tile */
 } board_type_e;
 
+/**
+ * @brief Tiles with the extreme pixel centers on each axis.
+ * Every tile has the same polygon around its center, so these tiles alone
+ * bound the whole board. Tiles are ranked by their lattice projection: the
+ * pixel center under the layout's orientation with unit size and no
+ * origin. Size, scale and origin only stretch and shift that projection,
+ * so changing them keeps the same tiles extreme (a negative size swaps
+ * least and greatest, and the bounds read all four). A different
+ * orientation does not; the extent notices and rescans.
+ */
+typedef struct {
+    grid_cell_t cells[4];      /* Least x, least y, greatest x, greatest y */
+    float projections[4];      /* Lattice projection of each on its axis */
+    orientation_t orientation; /* Orientation the projections were taken in */
+    bool has_tiles;            /* False while the board is empty */
+} board_extent_t;
+
 typedef struct {
     // Geometry configuration
     grid_type_e geometry_type;        /* Which grid geometry to use (hex, square, etc.) */
@@ -22,6 +44,11 @@ typedef struct {
 
     // Game data
     tile_map_t *tiles;
+    slab_t *tile_slab;                /* Storage for tiles created by the board */
+    tile_store_t *store;              /* Column copy of tile data for bulk sums */
+    bitboard_t *occupancy;            /* One bit per occupied cell in 'radius' */
+    board_extent_t extent;            /* Tiles that bound the board in pixels */
+    board_traversal_t *traversal;     /* Scratch stack and visit epoch */
     pool_manager_t *pools;
     uint32_t next_pool_id;
     Camera2D camera; // Camera for this board
@@ -33,14 +60,50 @@ void free_board(board_t *board);
 
 void board_randomize(board_t *board, int radius, board_type_e board_type);
 
-void board_add_tile(board_t *board, tile_t* tile);
+/**
+ * @brief Allocates a tile from the board's slab.
+ * The tile is not placed on the board; pass it to board_add_tile or
+ * board_add_tiles_batch. It stays valid until clear_board or free_board.
+ * @param board The board that owns the tile's storage.
+ * @param cell The cell the tile will occupy.
+ * @param data The tile's data.
+ * @return Pointer to the new tile, or NULL on allocation failure.
+ */
+tile_t *board_create_tile(board_t *board, grid_cell_t cell, tile_data_t data);
+
+/**
+ * @brief Places a tile on the board and assigns it to a pool.
+ * @return False, leaving the board unchanged, if the tile's cell is outside
+ * the board's radius.
+ */
+bool board_add_tile(board_t *board, tile_t* tile);
 void remove_tile(board_t *board, tile_t* tile);
 void board_fill(board_t *board, int radius, board_type_e board_type);
 void get_neighbor_pools(board_t *board, tile_t *tile, pool_t **out_pools, size_t max_neighbors);
 bool board_rotate(board_t *board, grid_cell_t center, int rotation_steps);
 void cycle_tile_type(board_t *board, tile_t *tile);
 
-void board_add_tiles_batch(board_t *board, tile_t **tiles, size_t count);
+/**
+ * @brief Adds several tiles without assigning pools.
+ * @return False if a tile lies outside the board's radius or the tile map
+ * could not take the tiles; the board is then unchanged.
+ */
+bool board_add_tiles_batch(board_t *board, tile_t **tiles, size_t count);
+
+/**
+ * @brief Places several tiles as one transaction.
+ * The tiles are inserted first; then one pass groups the new tiles by
+ * connected type, and each group joins (or merges) the pools it touches in
+ * a single step, so every affected pool's derived data is refreshed once.
+ * Pools end up as if the tiles had been placed one by one with
+ * board_add_tile.
+ * @param board The board to place the tiles on.
+ * @param tiles Tiles from board_create_tile; their cells must be empty.
+ * @param count Number of tiles.
+ * @return False if a tile lies outside the board's radius or the tile map
+ * could not take the tiles; the board is then unchanged.
+ */
+bool board_place_tiles(board_t *board, tile_t **tiles, size_t count);
 void assign_pools_batch(board_t *board);
 void flood_fill_assign_pool(board_t *board, tile_t *start_tile, pool_t *pool);
 void board_fill_batch(board_t *board, int radius, board_type_e board_type);
@@ -53,6 +116,26 @@ bool merge_boards(board_t *target_board, board_t *source_board, grid_cell_t targ
 grid_cell_t board_pixel_to_cell(const board_t *board, point_t point);
 
 tile_t *board_tile_at_cell(const board_t *board, grid_cell_t cell);
+
+/**
+ * @brief Checks whether a cell holds a tile, using the occupancy bitboard.
+ * @return True if the cell is within the board's radius and occupied.
+ */
+bool board_is_occupied(const board_t *board, grid_cell_t cell);
+
+/**
+ * @brief Counts the tiles of a type within 'range' of a cell, not counting
+ * the cell itself. Ranges up to HEX_STENCIL_MAX_RADIUS read precomputed
+ * offsets; see tile_map_count_range.
+ * @param type Tile type to count, or a negative value to count every tile.
+ */
+int board_count_in_range(const board_t *board, grid_cell_t cell, int range,
+                         int type);
+
+/**
+ * @brief Checks whether a cell lies within the board's radius.
+ */
+bool board_cell_in_bounds(const board_t *board, grid_cell_t cell);
 /**
  * @brief Validates that all tiles in a tile map are within the board's grid bounds.
  * @param board The board that defines the valid bounds.
@@ -61,8 +144,24 @@ tile_t *board_tile_at_cell(const board_t *board, grid_cell_t cell);
  */
 bool board_validate_tile_map_bounds(const board_t *board, const tile_map_t *tile_map);
 
+/**
+ * @brief Sums the production (value * modifier) of every tile on the board.
+ * @param board The board to sum.
+ * @param out Output totals, overall and per tile type.
+ */
+void board_sum_production(const board_t *board, tile_store_production_t *out);
+
+/**
+ * @brief Sums the production of the tiles in one pool.
+ * @param board The board holding the pool.
+ * @param pool_id The pool to sum; ids of pools merged into it also work.
+ * @return The pool's production, or 0 if the pool has no tiles.
+ */
+float board_pool_production(board_t *board, uint32_t pool_id);
+
 /**
  * @brief Calculates the smallest bounding box that contains all cells in the board.
+ * Reads the board's extent, so the cost does not grow with the tile count.
  * @param board The board to calculate bounds for.
  * @param out_min_x Output for minimum x coordinate.
  * @param out_min_y Output for minimum y coordinate.
@@ -72,4 +171,12 @@ bool board_validate_tile_map_bounds(const board_t *board, const tile_map_t *tile
  */
 bool board_calculate_bounds(const board_t *board, float *out_min_x, float *out_min_y, float *out_max_x, float *out_max_y);
 
+/**
+ * @brief Calculates the bounding box of every cell in the board's radius,
+ * occupied or not, in closed form.
+ * @return True if bounds were calculated successfully, false otherwise.
+ * Outputs are as for board_calculate_bounds.
+ */
+bool board_region_bounds(const board_t *board, float *out_min_x, float *out_min_y, float *out_max_x, float *out_max_y);
+
 #endif /* BOARD_H */
@@ -0,0 +1,28 @@
+#ifndef BOARD_LABELING_H
+#define BOARD_LABELING_H
+
+#include "game/board.h"
+
+/**
+ * @brief Assigns every tile of a hex board to a pool of its same-type
+ * connected component, labeling the components on several threads.
+ *
+ * The board's rows are split into stripes of about equal tile count. Each
+ * worker unions adjacent same-type tiles inside its stripe, the stripe
+ * borders are joined afterwards, and the workers then resolve every cell to
+ * its component root. Pools are created in one pass over the board's tile
+ * map and then filled by the workers, each owning a share of the pools and
+ * adding their tiles in tile map order, so pool ids, membership and pool
+ * contents match a serial flood fill that visits tiles in the same order.
+ * Components of a single tile stay singletons.
+ *
+ * Existing tile pool ids are overwritten; pools already in the manager are
+ * left alone.
+ *
+ * @param board The hex board to label.
+ * @param thread_count Number of workers; 0 or less picks one per online core.
+ * @return Number of pools created.
+ */
+size_t board_label_pools(board_t *board, int thread_count);
+
+#endif // BOARD_LABELING_H
@@ -0,0 +1,101 @@
+#ifndef BOARD_TRAVERSAL_H
+#define BOARD_TRAVERSAL_H
+
+#include "game/board.h"
+#include "third_party/kvec.h"
+
+/**
+ * @brief Scratch state shared by every traversal of one board.
+ *
+ * The stack grows to the largest traversal seen and is then reused, so
+ * traversals do not allocate in steady state. A tile counts as visited when
+ * its visit_epoch equals the board's current epoch; starting a traversal
+ * bumps the epoch, which clears every mark at once. Tile pool ids and other
+ * game state are never touched, so traversals are safe for previews.
+ *
+ * Only one traversal per board may run at a time; a callback must not start
+ * another traversal on the same board.
+ */
+struct board_traversal {
+    kvec_t(tile_t *) stack; /* Pending tiles; a queue for BFS */
+    uint32_t epoch;         /* Stamp of the current traversal */
+};
+
+/**
+ * @brief Decides whether a traversal may step from one tile to a neighbor.
+ * @param from The tile being expanded.
+ * @param to The neighbor tile, not yet visited.
+ * @param user_data The pointer passed to the traversal.
+ * @return True to visit 'to'.
+ */
+typedef bool (*board_traversal_filter_t)(const tile_t *from, const tile_t *to,
+                                         void *user_data);
+
+/**
+ * @brief Called once for every tile a traversal visits, in visiting order.
+ */
+typedef void (*board_traversal_visit_t)(tile_t *tile, void *user_data);
+
+/**
+ * @brief Creates the scratch state for a board.
+ * @return Pointer to the new state, or NULL on allocation failure.
+ */
+board_traversal_t *board_traversal_create(void);
+
+/**
+ * @brief Frees a board's scratch state.
+ * @param traversal The state to free; NULL is ignored.
+ */
+void board_traversal_free(board_traversal_t *traversal);
+
+/**
+ * @brief Starts a new traversal, clearing every visited mark in O(1).
+ * Only needed when marking tiles by hand; the traversals below call it.
+ * @param board The board to traverse.
+ * @return The new epoch.
+ */
+uint32_t board_traversal_begin(const board_t *board);
+
+/**
+ * @brief Marks a tile visited in the current traversal.
+ * @return True if the tile was not visited before.
+ */
+bool board_traversal_mark(const board_t *board, tile_t *tile);
+
+/**
+ * @brief Checks whether a tile was visited in the current traversal.
+ */
+bool board_traversal_is_marked(const board_t *board, const tile_t *tile);
+
+/**
+ * @brief Visits the tiles reachable from 'start' in breadth-first order.
+ * @param board The board to traverse.
+ * @param start The first tile visited.
+ * @param filter Decides which neighbors to step to; NULL accepts all.
+ * @param visit Called for each visited tile; may be NULL.
+ * @param user_data Passed to 'filter' and 'visit'.
+ * @return Number of tiles visited.
+ */
+size_t board_traverse_bfs(const board_t *board, tile_t *start,
+                          board_traversal_filter_t filter,
+                          board_traversal_visit_t visit, void *user_data);
+
+/**
+ * @brief Visits the tiles reachable from 'start' in depth-first order.
+ * Parameters and result are as for board_traverse_bfs.
+ */
+size_t board_traverse_dfs(const board_t *board, tile_t *start,
+                          board_traversal_filter_t filter,
+                          board_traversal_visit_t visit, void *user_data);
+
+/**
+ * @brief Breadth-first traversal that never leaves the cells within
+ * 'max_distance' of the start tile.
+ * @param max_distance Largest grid distance from 'start' to visit.
+ * Other parameters and result are as for board_traverse_bfs.
+ */
+size_t board_traverse_within(const board_t *board, tile_t *start,
+                             int max_distance, board_traversal_filter_t filter,
+                             board_traversal_visit_t visit, void *user_data);
+
+#endif // BOARD_TRAVERSAL_H
@@ -45,6 +45,5 @@ void game_exit_placement_mode(game_t *game);
 // Simplified preview system functions
 void game_set_preview(game_t *game, board_t *source_board, grid_cell_t target_position);
 void game_clear_preview(game_t *game);
-bool game_get_preview_conflicts(const game_t *game, grid_cell_t **out_conflicts, size_t *out_count);
 
 #endif // GAME_H
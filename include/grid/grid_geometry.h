@@ -4,10 +4,40 @@
 #include "grid_types.h"
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 // Forward declarations
 typedef struct grid_vtable_t grid_vtable_t;
 
+/**
+ * @brief Shapes a grid_iter_t can walk.
+ */
+typedef enum {
+    GRID_ITER_RANGE,  /* Every cell within a range, in get_cells_in_range order */
+    GRID_ITER_RINGS,  /* Rings from min_radius to max_radius, each in get_ring order */
+    GRID_ITER_LINE    /* Cells from a start cell to an end cell */
+} grid_iter_kind_e;
+
+/**
+ * @brief Stack-resident cursor that streams the cells of a range, ring,
+ * spiral or line without allocating.
+ *
+ * Start one with grid_iter_range, grid_iter_ring, grid_iter_spiral or
+ * grid_iter_line, then call grid_iter_next until it returns false. The
+ * fields are state for the grid implementation.
+ */
+typedef struct grid_iter {
+    const grid_vtable_t *vtable; /* NULL once the walk is over */
+    grid_iter_kind_e kind;
+    grid_cell_t center;   /* Center of the shape, or the start of a line */
+    grid_cell_t end;      /* End of a line */
+    int min_radius;       /* First ring walked */
+    int max_radius;       /* Range, last ring walked, or line length */
+    int radius;           /* Ring being walked */
+    int index;            /* Cells produced so far in this ring or line */
+    grid_cell_t cursor;   /* Next cell of the walk, or its offset for ranges */
+} grid_iter_t;
+
 /**
  * @brief Virtual function table for grid geometry implementations.
  *
@@ -82,6 +112,25 @@ struct grid_vtable_t {
      */
     void (*get_corners)(const layout_t* layout, grid_cell_t cell, point_t* corners);
 
+    /**
+     * @brief Computes the corners of a cell relative to its center.
+     * Only set for grid types whose cells all share the same corner offsets.
+     * @param layout The layout configuration for coordinate conversion.
+     * @param offsets Output array for corner offsets (must be sized for grid type).
+     */
+    void (*get_corner_offsets)(const layout_t* layout, point_t* offsets);
+
+    /**
+     * @brief Converts many grid cells to pixel coordinates at once.
+     * May be NULL; callers then fall back to cell_to_pixel.
+     * @param layout The layout configuration for coordinate conversion.
+     * @param cells The cells to convert.
+     * @param count Number of cells.
+     * @param out_xy Output for 2 * count floats, x and y interleaved.
+     */
+    void (*cells_to_pixels)(const layout_t* layout, const grid_cell_t* cells,
+                            size_t count, float* out_xy);
+
     /**
      * @brief Calculates offset between two cells.
      * @param from Source cell.
@@ -124,6 +173,44 @@ struct grid_vtable_t {
     void (*get_line)(grid_cell_t start, grid_cell_t end,
                     grid_cell_t** out_cells, size_t* out_count);
 
+    /**
+     * @brief Gets every cell within a radius, center first, ring by ring.
+     * @param center The center cell.
+     * @param max_radius The largest ring included.
+     * @param out_cells Output array for cells (caller frees).
+     * @param out_count Output parameter for number of cells found.
+     */
+    void (*get_spiral)(grid_cell_t center, int max_radius,
+                      grid_cell_t** out_cells, size_t* out_count);
+
+    /**
+     * @brief Gets the cells at the corners of the region within a radius.
+     * Every cell's polygon is the same shape, so the cells with the extreme
+     * pixel centers bound the whole region; for hexes these are the six
+     * cells 'radius' steps from the center in each direction.
+     * @param center The center cell.
+     * @param radius The region's radius.
+     * @param out_cells Output for the cells; holds GRID_MAX_CORNERS cells.
+     * @return Number of cells written.
+     */
+    int (*get_region_corners)(grid_cell_t center, int radius,
+                              grid_cell_t* out_cells);
+
+    /**
+     * @brief Positions an iterator on the first cell of its shape.
+     * Called by the grid_iter_* start functions once the shape is filled in.
+     * @param iter The iterator to start.
+     */
+    void (*iter_begin)(grid_iter_t* iter);
+
+    /**
+     * @brief Produces the next cell of an iterator's shape.
+     * @param iter The iterator.
+     * @param out_cell Output for the cell.
+     * @return False once every cell was produced.
+     */
+    bool (*iter_next)(grid_iter_t* iter, grid_cell_t* out_cell);
+
     /**
      * @brief Checks if two cells are equal.
      * @param a First cell.
@@ -213,6 +300,47 @@ int grid_geometry_distance(grid_type_e type, grid_cell_t a, grid_cell_t b);
 void grid_geometry_get_corners(grid_type_e type, const layout_t* layout,
                                grid_cell_t cell, point_t* corners);
 
+/**
+ * @brief Converts many cells to pixel coordinates at once.
+ * @param type The grid type.
+ * @param layout The layout configuration for coordinate conversion.
+ * @param cells The cells to convert.
+ * @param count Number of cells.
+ * @param out_xy Output for 2 * count floats, x and y interleaved, which is
+ * the memory layout of an array of 2D float vectors.
+ */
+void grid_geometry_cells_to_pixels(grid_type_e type, const layout_t* layout,
+                                   const grid_cell_t* cells, size_t count,
+                                   float* out_xy);
+
+/**
+ * @brief Gets the corner points of many cells at once.
+ * @param type The grid type.
+ * @param layout The layout configuration for coordinate conversion.
+ * @param cells The cells.
+ * @param count Number of cells.
+ * @param out_xy Output for 2 * corner_count * count floats: each cell's
+ * corners in grid_geometry_get_corners order, x and y interleaved.
+ */
+void grid_geometry_get_corners_batch(grid_type_e type, const layout_t* layout,
+                                     const grid_cell_t* cells, size_t count,
+                                     float* out_xy);
+
+/**
+ * @brief Rebuilds the corner template cached in a layout.
+ * Call after changing the layout's size, scale or orientation; until then
+ * corners are computed without the template.
+ * @param type The grid type.
+ * @param layout The layout to update.
+ */
+void grid_geometry_update_layout(grid_type_e type, layout_t* layout);
+
+/**
+ * @brief Checks whether a layout's corner template matches its size, scale
+ * and orientation.
+ */
+bool grid_geometry_layout_corners_current(const layout_t* layout);
+
 /**
  * @brief Rotates a cell around the origin.
  */
@@ -248,6 +376,51 @@ void grid_geometry_get_ring(grid_type_e type, grid_cell_t center, int radius,
 void grid_geometry_get_line(grid_type_e type, grid_cell_t start, grid_cell_t end,
                             grid_cell_t** out_cells, size_t* out_count);
 
+/**
+ * @brief Gets every cell within a radius, the center first and then each
+ * ring outwards.
+ */
+void grid_geometry_get_spiral(grid_type_e type, grid_cell_t center,
+                              int max_radius, grid_cell_t** out_cells,
+                              size_t* out_count);
+
+/**
+ * @brief Starts streaming the cells within 'range' of 'center', in
+ * grid_geometry_get_cells_in_range order.
+ */
+void grid_iter_range(grid_iter_t* iter, grid_type_e type, grid_cell_t center,
+                     int range);
+
+/**
+ * @brief Starts streaming the ring at exactly 'radius' from 'center', in
+ * grid_geometry_get_ring order.
+ */
+void grid_iter_ring(grid_iter_t* iter, grid_type_e type, grid_cell_t center,
+                    int radius);
+
+/**
+ * @brief Starts streaming the cells within 'max_radius' of 'center', the
+ * center first and then each ring outwards.
+ */
+void grid_iter_spiral(grid_iter_t* iter, grid_type_e type, grid_cell_t center,
+                      int max_radius);
+
+/**
+ * @brief Starts streaming the cells on the line from 'start' to 'end', in
+ * grid_geometry_get_line order.
+ */
+void grid_iter_line(grid_iter_t* iter, grid_type_e type, grid_cell_t start,
+                    grid_cell_t end);
+
+/**
+ * @brief Gets the next cell of an iterator.
+ * @param iter The iterator.
+ * @param out_cell Output for the cell.
+ * @return False once every cell was produced, or if the grid type does not
+ * support iterators.
+ */
+bool grid_iter_next(grid_iter_t* iter, grid_cell_t* out_cell);
+
 /**
  * @brief Checks if two cells are equal.
  */
@@ -292,6 +465,20 @@ int grid_geometry_calculate_diameter(grid_type_e type, grid_cell_t* cells,
 grid_cell_t grid_geometry_calculate_center(grid_type_e type, grid_cell_t* cells,
                                            size_t cell_count);
 
+/**
+ * @brief Calculates the center of a cell collection from its running
+ * coordinate sums, in O(1).
+ * Hex centers are rounded to the nearest cell, which is always a valid cube
+ * coordinate (q + r + s == 0).
+ * @param type The grid type; only hexagonal grids are supported.
+ * @param sums Sums of the cells' q, r and s coordinates.
+ * @param cell_count Number of cells summed.
+ * @return The center cell, or a GRID_TYPE_UNKNOWN cell if unsupported.
+ */
+grid_cell_t grid_geometry_center_from_sums(grid_type_e type,
+                                           const int64_t sums[3],
+                                           size_t cell_count);
+
 /**
  * @brief Counts external edges of a cell collection.
  * @param type The grid type.
@@ -329,6 +516,25 @@ bool grid_geometry_calculate_bounds(grid_type_e type, const layout_t* layout,
                                     float* out_min_x, float* out_min_y,
                                     float* out_max_x, float* out_max_y);
 
+/**
+ * @brief Calculates the bounding box of every cell within a radius without
+ * visiting them. Grids with a get_region_corners hook take the bounds of
+ * the region's corner cells; others fall back to walking the region.
+ * @param type The grid type.
+ * @param layout The layout configuration for coordinate conversion.
+ * @param center The region's center.
+ * @param radius The region's radius.
+ * @param out_min_x Output for minimum x coordinate.
+ * @param out_min_y Output for minimum y coordinate.
+ * @param out_max_x Output for maximum x coordinate.
+ * @param out_max_y Output for maximum y coordinate.
+ * @return True if bounds were calculated successfully, false otherwise.
+ */
+bool grid_geometry_region_bounds(grid_type_e type, const layout_t* layout,
+                                 grid_cell_t center, int radius,
+                                 float* out_min_x, float* out_min_y,
+                                 float* out_max_x, float* out_max_y);
+
 // --- Registration of grid implementations ---
 
 /**
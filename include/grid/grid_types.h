@@ -87,14 +87,27 @@ typedef struct {
     double start_angle;     /* Orientation angle in multiples of 60 degrees for hexes */
 } orientation_t;
 
+/**
+ * @brief Largest number of corners of any supported cell shape
+ */
+#define GRID_MAX_CORNERS 6
+
 /**
  * @brief Holds all layout information for a grid needed for coordinate conversion
+ *
+ * Every cell of a grid has the same corners relative to its center, so the
+ * layout caches them as a template. The template records the scaled size and
+ * start angle it was built for and is ignored once those no longer match;
+ * grid_geometry_update_layout rebuilds it.
  */
 typedef struct {
     orientation_t orientation;
     point_t size;           /* Size of a single cell (e.g., width and height) */
     point_t origin;         /* Pixel offset for the grid's origin (0,0) */
     double scale;           /* Scale multiplier for the entire grid (1.0 = normal, 2.0 = double size) */
+    point_t corner_offsets[GRID_MAX_CORNERS]; /* Corners relative to a cell center */
+    point_t corner_extent;  /* size * scale the corner template was built for */
+    double corner_angle;    /* start_angle the corner template was built for */
 } layout_t;
 
 /**
@@ -0,0 +1,151 @@
+#ifndef HEX_KERNELS_H
+#define HEX_KERNELS_H
+
+#include "grid_geometry.h"
+#include <stdlib.h>
+
+/**
+ * @brief Inline hex geometry for hot loops.
+ *
+ * The grid_geometry_* functions reach the hex code through the vtable, which
+ * the compiler cannot inline, and take tagged grid_cell_t values that every
+ * implementation re-checks. These kernels work on bare cube coordinates and
+ * compile down to a few adds, so loops such as flood fills and edge counts
+ * can inline them. hex_geometry.c implements its vtable with the same
+ * kernels, so both paths agree.
+ *
+ * Directions follow hex_get_neighbor: 0 = E, 1 = NE, 2 = NW, 3 = W, 4 = SW,
+ * 5 = SE, with direction d and d + 3 opposite.
+ */
+
+/**
+ * @brief Wraps cube coordinates in a hexagon grid cell.
+ */
+static inline grid_cell_t hex_kernel_cell(hex_coord_t h) {
+    grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+    cell.coord.hex = h;
+    return cell;
+}
+
+/**
+ * @brief Unit step in a direction; 'direction' must be in 0..5.
+ */
+static inline hex_coord_t hex_kernel_direction(int direction) {
+    static const hex_coord_t directions[6] = {
+      {1, 0, -1}, {1, -1, 0}, {0, -1, 1}, {-1, 0, 1}, {-1, 1, 0}, {0, 1, -1}};
+    return directions[direction];
+}
+
+/**
+ * @brief Gets the neighbor in a direction; 'direction' must be in 0..5.
+ */
+static inline hex_coord_t hex_kernel_neighbor(hex_coord_t h, int direction) {
+    hex_coord_t step = hex_kernel_direction(direction);
+    return (hex_coord_t){h.q + step.q, h.r + step.r, h.s + step.s};
+}
+
+/**
+ * @brief Gets all six neighbors as grid cells, in direction order.
+ */
+static inline void hex_kernel_all_neighbors(hex_coord_t h,
+                                            grid_cell_t *out_neighbors) {
+    for (int d = 0; d < 6; d++) {
+        out_neighbors[d] = hex_kernel_cell(hex_kernel_neighbor(h, d));
+    }
+}
+
+/**
+ * @brief Number of steps between two cells.
+ */
+static inline int hex_kernel_distance(hex_coord_t a, hex_coord_t b) {
+    return (abs(a.q - b.q) + abs(a.q + a.r - b.q - b.r) + abs(a.r - b.r)) / 2;
+}
+
+/**
+ * @brief Offset that moves 'from' onto 'to'.
+ */
+static inline hex_coord_t hex_kernel_offset(hex_coord_t from, hex_coord_t to) {
+    return (hex_coord_t){to.q - from.q, to.r - from.r, to.s - from.s};
+}
+
+/**
+ * @brief Moves a cell by an offset.
+ */
+static inline hex_coord_t hex_kernel_apply(hex_coord_t h, hex_coord_t offset) {
+    return (hex_coord_t){h.q + offset.q, h.r + offset.r, h.s + offset.s};
+}
+
+/**
+ * @brief Rotates a cell around the origin by 'rotations' 60-degree steps,
+ * each mapping (q, r, s) to (-r, -s, -q). Any integer count is accepted.
+ */
+static inline hex_coord_t hex_kernel_rotate(hex_coord_t h, int rotations) {
+    switch (((rotations % 6) + 6) % 6) {
+    case 1:
+        return (hex_coord_t){-h.r, -h.s, -h.q};
+    case 2:
+        return (hex_coord_t){h.s, h.q, h.r};
+    case 3:
+        return (hex_coord_t){-h.q, -h.r, -h.s};
+    case 4:
+        return (hex_coord_t){h.r, h.s, h.q};
+    case 5:
+        return (hex_coord_t){-h.s, -h.q, -h.r};
+    default:
+        return h;
+    }
+}
+
+/**
+ * @brief Gets cell 'index' of the ring at 'radius' around 'center', in the
+ * order hex_get_ring lists them: starting 'radius' steps SW of the center
+ * and walking directions 0..5 for 'radius' steps each.
+ * @param index Position on the ring, 0 <= index < 6 * radius; ignored when
+ * the radius is 0, whose ring is the center alone.
+ */
+static inline hex_coord_t hex_kernel_ring_cell(hex_coord_t center, int radius,
+                                               int index) {
+    if (radius <= 0)
+        return center;
+    int side = index / radius;
+    int step = index % radius;
+    hex_coord_t start = hex_kernel_direction(4);
+    int q = center.q + radius * start.q;
+    int r = center.r + radius * start.r;
+    for (int d = 0; d < side; d++) {
+        q += radius * hex_kernel_direction(d).q;
+        r += radius * hex_kernel_direction(d).r;
+    }
+    q += step * hex_kernel_direction(side).q;
+    r += step * hex_kernel_direction(side).r;
+    return (hex_coord_t){q, r, -q - r};
+}
+
+// --- Grid-type dispatch ---
+// Board and pool code know their grid type only at run time. These take the
+// inline hex path for hexagon grids and fall back to the vtable otherwise;
+// the branch is the same on every call, so it predicts perfectly.
+
+/**
+ * @brief Inline counterpart of grid_geometry_get_all_neighbors.
+ */
+static inline void hex_kernel_grid_neighbors(grid_type_e type, grid_cell_t cell,
+                                             grid_cell_t *out_neighbors) {
+    if (type == GRID_TYPE_HEXAGON && cell.type == GRID_TYPE_HEXAGON)
+        hex_kernel_all_neighbors(cell.coord.hex, out_neighbors);
+    else
+        grid_geometry_get_all_neighbors(type, cell, out_neighbors);
+}
+
+/**
+ * @brief Inline counterpart of grid_geometry_distance.
+ */
+static inline int hex_kernel_grid_distance(grid_type_e type, grid_cell_t a,
+                                           grid_cell_t b) {
+    if (type == GRID_TYPE_HEXAGON && a.type == GRID_TYPE_HEXAGON &&
+        b.type == GRID_TYPE_HEXAGON)
+        return hex_kernel_distance(a.coord.hex, b.coord.hex);
+    return grid_geometry_distance(type, a, b);
+}
+
+#endif // HEX_KERNELS_H
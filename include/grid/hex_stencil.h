@@ -0,0 +1,49 @@
+#ifndef HEX_STENCIL_H
+#define HEX_STENCIL_H
+
+#include "grid_types.h"
+#include <stdint.h>
+
+/**
+ * @brief Precomputed axial offsets of every cell within a fixed radius.
+ *
+ * The offsets are in spiral order: the center, then ring 1, ring 2 and so
+ * on, each ring in get_ring order. The stencil of radius r is therefore the
+ * first HEX_STENCIL_COUNT(r) entries, and ring r alone is the entries from
+ * HEX_STENCIL_COUNT(r - 1) up to HEX_STENCIL_COUNT(r). Range queries read
+ * the offsets instead of regenerating them for each center; dense tile maps
+ * turn them into slot index deltas once (see tile_map_collect_range).
+ */
+
+// Largest stencil radius; matches MAX_RULE_RANGE of the rule system
+#define HEX_STENCIL_MAX_RADIUS 9
+
+// Number of cells within 'radius', and so the length of its stencil
+#define HEX_STENCIL_COUNT(radius) (3 * (radius) * ((radius) + 1) + 1)
+
+// Entries in the full table
+#define HEX_STENCIL_SIZE HEX_STENCIL_COUNT(HEX_STENCIL_MAX_RADIUS)
+
+/**
+ * @brief Axial offset (dq, dr) from a center cell; ds is -dq - dr.
+ */
+typedef struct {
+    int8_t dq;
+    int8_t dr;
+} hex_stencil_offset_t;
+
+extern const hex_stencil_offset_t hex_stencil_offsets[HEX_STENCIL_SIZE];
+
+/**
+ * @brief Applies stencil entry 'index' to a hex cell.
+ */
+static inline grid_cell_t hex_stencil_cell(grid_cell_t center, int index) {
+    hex_stencil_offset_t offset = hex_stencil_offsets[index];
+    grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+    cell.coord.hex.q = center.coord.hex.q + offset.dq;
+    cell.coord.hex.r = center.coord.hex.r + offset.dr;
+    cell.coord.hex.s = center.coord.hex.s - offset.dq - offset.dr;
+    return cell;
+}
+
+#endif // HEX_STENCIL_H
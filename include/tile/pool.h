@@ -9,9 +9,44 @@
 #include "../grid/grid_types.h" // For grid_cell_t
 #include "../tile/tile_map.h"
 #include "tile.h"
+#include "../utility/slab.h"
 #include <stdlib.h>
 #include "third_party/kvec.h"
 
+/**
+ * @brief Running bounds of a pool's cube coordinates (q, r, s).
+ * Hex distance is the largest per-axis difference, so the widest axis is the
+ * pool's diameter. Adding a tile widens the bounds in O(1); removing a tile
+ * on a bound marks them dirty until the next rebuild.
+ */
+typedef struct {
+    int min[3];  // Smallest q, r, s; INT_MAX while empty
+    int max[3];  // Largest q, r, s; INT_MIN while empty
+    bool dirty;  // A tile on a bound left; rebuild before use
+} pool_extents_t;
+
+/**
+ * @brief One cell of a pool's frontier, the cells next to the pool that are
+ * not part of it. 'count' is how many of the pool's tiles touch the cell, so
+ * the frontier can be updated per tile without rescanning the pool.
+ */
+typedef struct pool_frontier_entry {
+    tile_map_key_t key;  // Key: packed 'cell'
+    grid_cell_t cell;
+    int count;           // Pool tiles adjacent to 'cell'
+    UT_hash_handle hh;
+} pool_frontier_entry_t;
+
+/**
+ * @brief One link of the pool adjacency graph: another pool whose tiles
+ * share edges with this pool's tiles, and how many edges they share.
+ */
+typedef struct pool_adjacency_entry {
+    struct tile_pool *pool;  // Key: the adjacent pool
+    int shared_edges;        // Tile edges between the two pools
+    UT_hash_handle hh;
+} pool_adjacency_entry_t;
+
 // --- Enums ---
 /**
  * @brief Enum representing the type or color of a tile pool.
@@ -24,15 +59,29 @@
      tile_map_t *tiles;
      tile_type_t accepted_tile_type;
 
-     kvec_t(grid_cell_t) neighbor_cells;
-     kvec_t(tile_t*) neighbor_tiles;
+     pool_frontier_entry_t *frontier; // Cells next to the pool, with counts
+     slab_t *frontier_slab;           // Storage for frontier entries
+     kvec_t(tile_t*) neighbor_tiles;  // Board tiles on the frontier (lazy)
+     bool neighbor_tiles_dirty;       // neighbor_tiles must be rebuilt
+     pool_adjacency_entry_t *adjacent; // Pools sharing edges with this one
 
      // Pool modifier (can be negative/positive)
      float modifier;
 
+     // Score, cached until membership or the modifier changes
+     float score;
+     bool score_dirty;
+     size_t leaderboard_index; // Slot in the pool manager's leaderboard
+
      // Geometric properties
      int diameter;              // Farthest distance between any two tiles
      int edge_count;           // External edges
+     int internal_edge_count;  // Edges shared by two tiles of the pool
+     pool_extents_t extents;   // Cube-coordinate bounds (hex pools)
+     int64_t coord_sums[3];    // Sums of member q, r, s (hex pools)
+     // Member tiles by same-type neighbor count; the top nonzero bucket is
+     // highest_n
+     int neighbor_histogram[TILE_MAX_NEIGHBORS + 1];
      float compactness_score;  // Normalized compactness (0.0-1.0, 1.0 = perfect)
  } pool_t;
 
@@ -53,14 +102,24 @@ void pool_free(pool_t* pool);
 
 int pool_tile_score(const pool_t *pool);
 
+/**
+ * @brief Returns the pool's score: its tile count scaled by its modifier.
+ * The value is cached and only recomputed after the pool's tiles or
+ * modifier changed.
+ * @param pool Pointer to the pool.
+ * @return The score, or 0 for NULL.
+ */
+float pool_get_score(pool_t *pool);
+
 // --- Pool Membership Functions ---
 
 /**
  * @brief Removes a tile from a pool.
  * @param pool A pointer to the pool to remove the tile from.
  * @param tile_ptr A pointer to the tile_t to remove.
+ * @param geometry_type Grid geometry, for the pool's edge counters.
  */
-void pool_remove_tile(const pool_t* pool, const tile_t* tile_ptr);
+void pool_remove_tile(pool_t* pool, const tile_t* tile_ptr, grid_type_e geometry_type);
 
 void
 pool_update (pool_t *pool, grid_type_e grid_type);
@@ -76,7 +135,24 @@ bool pool_accepts_tile_type(const pool_t *pool, tile_type_t type);
 
 void pool_update_edges (grid_type_e grid_type, const layout_t *layout, pool_t *pool);
 
-void pool_update_center(pool_t *pool);
+/**
+ * @brief Stores the pool's current center in pool->center.
+ * O(1) for hex pools; see pool_calculate_center.
+ * @param pool Pointer to the pool.
+ * @param geometry_type The grid geometry type for calculations.
+ */
+void pool_update_center(pool_t *pool, grid_type_e geometry_type);
+
+/**
+ * @brief Re-keys a pool after its (shared) tiles were moved by 'transform'.
+ * Rebuilds the pool's tile index, maps its coordinate sums and extents
+ * through the transform in closed form (so the center is recomputed in
+ * O(1)), and re-keys its frontier cells.
+ * @param pool The pool whose tiles moved.
+ * @param transform The transform that was applied to the tiles.
+ * @return True on success, false on memory allocation failure.
+ */
+bool pool_apply_transform(pool_t *pool, const tile_map_transform_t *transform);
 
 int compare_pools_by_score(const void *a, const void *b);
 
@@ -84,6 +160,10 @@ int
 pool_find_tile_friendly_neighbor_count (tile_map_t *tile_map,
                                         const tile_t *tile, grid_type_e grid_type);
 
+/**
+ * @brief Largest number of same-type neighbors of any tile in the pool,
+ * read from the pool's neighbor histogram.
+ */
 int
 pool_find_max_tile_neighbors_in_pool (pool_t *pool, grid_type_e grid_type);
 
@@ -92,12 +172,22 @@ pool_calculate_score (pool_t *pool, grid_type_e grid_type);
 
 
 /**
- * @brief Updates the neighbors of a pool. First cells then tiles.
+ * @brief Marks the pool's neighbor tiles stale, e.g. after a tile was placed
+ * on or removed from its frontier. The frontier itself is always current.
+ * @param pool Pointer to the pool.
+ */
+void pool_invalidate_neighbor_tiles(pool_t *pool);
+
+/**
+ * @brief Returns the board tiles on the pool's frontier.
+ * Rebuilds the list from the frontier first if it is stale.
  * @param pool Pointer to the pool.
- * @param board_tiles Pointer to the tile map.
- * @param grid_type Type of grid.
+ * @param board_tiles All tiles on the board.
+ * @param out_count Optional output: number of tiles returned.
+ * @return The pool's neighbor tiles; owned by the pool.
  */
-void pool_update_neighbors(pool_t *pool, const tile_map_t *board_tiles, grid_type_e grid_type);
+tile_t **pool_get_neighbor_tiles(pool_t *pool, const tile_map_t *board_tiles,
+                                 size_t *out_count);
 /**
  * @brief Adds a tile to a pool.
  * @param pool A pointer to the pool to add the tile to.
@@ -107,7 +197,24 @@ void pool_update_neighbors(pool_t *pool, const tile_map_t *board_tiles, grid_typ
  bool
 pool_add_tile (pool_t *pool, const tile_t *tile_ptr, grid_type_e geometry_type, const tile_map_t *board_tiles);
 
+/**
+ * @brief Adds several tiles to a pool, refreshing its geometric properties
+ * once instead of after every tile.
+ * Tiles already in the pool or of another type are skipped.
+ * @param pool A pointer to the pool to add the tiles to.
+ * @param tiles The tiles to add.
+ * @param count Number of tiles.
+ * @return Number of tiles added.
+ */
+size_t pool_add_tiles(pool_t *pool, tile_t *const *tiles, size_t count,
+                      grid_type_e geometry_type, const tile_map_t *board_tiles);
+
 // --- Modifier Functions ---
+//
+// The pool manager's leaderboard is ordered by each pool's cached score.
+// These only mark the score dirty; for a pool owned by a manager, change the
+// modifier through pool_manager_set_pool_modifier or
+// pool_manager_add_pool_modifier so the leaderboard is re-sifted.
 
 /**
  * @brief Sets the modifier value for a pool.
@@ -141,6 +248,8 @@ void pool_update_geometric_properties(pool_t *pool, grid_type_e geometry_type);
 
 /**
  * @brief Calculates the diameter (maximum distance between any two tiles) of a pool.
+ * Hex pools read it from their extents in O(1), or O(n) while the extents
+ * are dirty; other geometries compare every pair of tiles.
  * @param pool Pointer to the pool.
  * @param geometry_type The grid geometry type for calculations.
  * @return The diameter of the pool, or 0 if less than 2 tiles.
@@ -149,6 +258,8 @@ int pool_calculate_diameter(const pool_t *pool, grid_type_e geometry_type);
 
 /**
  * @brief Calculates the geometric center of a pool.
+ * Hex pools round the mean of their running coordinate sums to the nearest
+ * cell in O(1); other geometries average the tiles.
  * @param pool Pointer to the pool.
  * @param geometry_type The grid geometry type for calculations.
  * @return The geometric center as a grid cell.
@@ -158,12 +269,11 @@ grid_cell_t pool_calculate_center(const pool_t *pool, grid_type_e geometry_type)
 /**
  * @brief Retrieve all neighbor grid cells of a pool. No duplicats, and no cells inside the pool.
  * @param pool Pointer to the pool.
- * @param geometry_type The grid geometry type for calculations.
- * @param out_cells Pointer to an array to store the neighbor grid cells.
+ * @param out_cells Pointer to an array to store the neighbor grid cells, or
+ *                  NULL to only count them.
  * @return The number of neighbor grid cells retrieved.
  */
-int pool_get_neighbor_cells(const pool_t *pool, grid_type_e geometry_type,
-                         grid_cell_t *out_cells);
+int pool_get_neighbor_cells(const pool_t *pool, grid_cell_t *out_cells);
 /**
  * @brief Calculates the number of external edges of a pool.
  * @param pool Pointer to the pool.
@@ -173,13 +283,103 @@ int pool_get_neighbor_cells(const pool_t *pool, grid_type_e geometry_type,
 int pool_calculate_edge_count(const pool_t *pool, grid_type_e geometry_type);
 
 /**
- * @brief Calculates the compactness score of a pool.
+ * @brief Calculates the compactness score of a pool from its edge counters.
  * @param pool Pointer to the pool.
  * @return The compactness score (0.0-1.0, where 1.0 represents perfect compactness).
  */
 float pool_calculate_compactness_score(const pool_t *pool);
 
+// --- Incremental Tracking ---
+// The edge counters and extents are kept up to date as tiles come and go,
+// so they never need a full recount. Code that edits pool->tiles directly
+// must report each change through these functions.
 
+/**
+ * @brief Updates the edge counters and extents for a tile that joined the pool.
+ * May be called before or after the tile is put in pool->tiles.
+ */
+void pool_track_tile_added(pool_t *pool, const tile_t *tile, grid_type_e geometry_type);
+
+/**
+ * @brief Updates the edge counters and extents for a tile that left the pool.
+ * May be called before or after the tile is taken out of pool->tiles.
+ */
+void pool_track_tile_removed(pool_t *pool, const tile_t *tile, grid_type_e geometry_type);
+
+/**
+ * @brief Folds the edge counters, extents and adjacency links of 'absorbed'
+ * into 'keep'. Must be called before the absorbed tiles are put in
+ * keep->tiles.
+ */
+void pool_track_merge(pool_t *keep, const pool_t *absorbed, grid_type_e geometry_type);
+
+/**
+ * @brief Moves a member tile between neighbor histogram buckets after its
+ * same-type mask changed, e.g. when a tile was placed next to it.
+ * @param old_count The tile's same-type neighbor count before the change.
+ * @param new_count The count after the change.
+ */
+void pool_track_neighbor_count_changed(pool_t *pool, int old_count, int new_count);
+
+/**
+ * @brief Rebuilds the pool's extents from its tiles if they are dirty.
+ * @param pool Pointer to the pool.
+ */
+void pool_refresh_extents(pool_t *pool);
+
+/**
+ * @brief Reads the pool's cube-coordinate bounds (hex pools).
+ * O(1) unless a tile on a bound left since the last read.
+ * @param pool Pointer to the pool.
+ * @param out_min Smallest q, r and s of any tile.
+ * @param out_max Largest q, r and s of any tile.
+ * @return False if the pool is empty.
+ */
+bool pool_get_bounds(pool_t *pool, int out_min[3], int out_max[3]);
+
+/**
+ * @brief Cross-checks the edge counters and neighbor histogram against a
+ * brute-force recount.
+ * Compiling with POOL_VERIFY_EDGES runs this after every geometric update.
+ * @return True if everything matches.
+ */
+bool pool_verify_edge_counts(const pool_t *pool, grid_type_e geometry_type);
+
+
+
+// --- Pool Adjacency ---
+// Pools whose tiles touch are linked both ways with their shared edge
+// count. Links are keyed by pool pointer, so they survive the id change of a
+// merge survivor. The pool manager keeps them current; pool_free unlinks a
+// pool from all of its neighbors.
+
+/**
+ * @brief Changes the number of tile edges two pools share.
+ * Both sides of the link change; a link whose count reaches 0 is removed.
+ * @param delta Edges gained (positive) or lost (negative).
+ */
+void pool_adjacency_add(pool_t *a, pool_t *b, int delta);
+
+/**
+ * @brief Number of tile edges two pools share, or 0 if they do not touch.
+ */
+int pool_adjacency_shared_edges(const pool_t *a, const pool_t *b);
+
+/**
+ * @brief Removes every link of a pool, on both sides.
+ */
+void pool_adjacency_clear(pool_t *pool);
+
+/**
+ * @brief Lists the pools that touch 'pool', in O(degree).
+ * @param pool Pointer to the pool.
+ * @param type Only pools of this tile type; TILE_UNDEFINED for any.
+ * @param out_pools Output array, or NULL to only count.
+ * @param max_pools Capacity of 'out_pools'.
+ * @return Number of matching pools; may exceed 'max_pools'.
+ */
+size_t pool_get_adjacent_pools(const pool_t *pool, tile_type_t type,
+                               pool_t **out_pools, size_t max_pools);
 
 /**
  * @brief Prints all easily printable properties of a pool.
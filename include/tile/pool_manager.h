@@ -3,6 +3,7 @@
 
 #include "pool.h"
 #include "../third_party/uthash.h"
+#include "../utility/disjoint_set.h"
 
 // --- Pool Hash Table Entry ---
 // This struct is managed by UTHash.
@@ -14,10 +15,17 @@ typedef struct pool_manager_entry {
 
 // --- Pool Map Container ---
 // Encapsulates the hash table and associated metadata.
+// Every pool id ever handed out is an element of 'labels'. Merging two pools
+// joins their labels, so a tile's pool_id may name a pool that was absorbed
+// since; pool_manager_resolve_id maps it to the live pool's id.
+// 'leaderboard' is a binary max-heap of every live pool by score (ties go to
+// the lower id); each pool records its slot in leaderboard_index.
 typedef struct pool_manager {
     pool_manager_entry_t *root; // Root hash table pointer
     size_t num_pools;          // Number of pools in the map
     int next_id;
+    disjoint_set_t *labels;    // Union-find over pool ids (0 = no pool)
+    kvec_t(pool_t *) leaderboard; // Max-heap of live pools by score
 } pool_manager_t;
 
 // Create and initialize a new pool map.
@@ -41,24 +49,69 @@ pool_manager_entry_t *pool_manager_find_by_id(pool_manager_t *map, int pool_id);
 pool_t *pool_manager_get_pool(pool_manager_t *map, int pool_id);
 pool_t *pool_manager_get_pool_by_tile(pool_manager_t *map, tile_t* tile);
 
-// Optionally, if you need to map from a tile (or tile id) to a pool, add:
+// Find the entry of the pool a tile belongs to, via its resolved pool_id.
 pool_manager_entry_t *pool_manager_find_by_tile(pool_manager_t *map, tile_t* tile);
 
+/**
+ * @brief Maps a pool id, possibly of an absorbed pool, to the live pool's id.
+ * @param map The pool manager.
+ * @param pool_id Any id the manager handed out; 0 stays 0.
+ * @return The id of the pool that now holds the id's tiles.
+ */
+uint32_t pool_manager_resolve_id(pool_manager_t *map, uint32_t pool_id);
+
+/**
+ * @brief Resolves a tile's pool_id and stores the result back in the tile.
+ * @param map The pool manager.
+ * @param tile The tile to refresh.
+ * @return The tile's current pool id, 0 for singletons.
+ */
+uint32_t pool_manager_tile_pool_id(pool_manager_t *map, tile_t *tile);
+
 bool pool_manager_contains_tile(pool_manager_t *map, tile_t* tile);
 
 // --- New Pool Management Functions ---
 
 /**
- * @brief Merges source pool into target pool, moving all tiles and updating neighbors.
+ * @brief Merges two pools and updates the survivor's neighbors.
+ *
+ * The pool with fewer tiles is absorbed: its tiles are spliced into the
+ * larger pool's map and it is freed. The two ids are joined in the manager's
+ * union-find, so tiles keep their old pool_id until it is next resolved.
+ *
  * @param manager The pool manager.
- * @param target_id ID of the pool to merge into.
- * @param source_id ID of the pool to merge from (will be removed).
+ * @param target_id ID of the first pool.
+ * @param source_id ID of the second pool.
  * @param geometry_type Grid geometry for neighbor calculations.
- * @param board_tiles All tiles on the board for neighbor lookups.
+ * @param board_tiles Unused; the frontiers already hold the neighbor cells.
+ * @return The surviving pool, or NULL if either id has no live pool.
  */
-void pool_manager_merge_pools(pool_manager_t *manager, int target_id, int source_id,
+pool_t *pool_manager_merge_pools(pool_manager_t *manager, int target_id, int source_id,
                               grid_type_e geometry_type, tile_map_t *board_tiles);
 
+/**
+ * @brief Splits a pool that may have been disconnected by removing a tile.
+ *
+ * Call after the tile at 'removed_cell' has left the pool. One search starts
+ * from each of the cell's neighbors in the pool; the searches advance in
+ * lockstep and merge when they meet. Each fragment that is fully explored
+ * while another search is still running moves to a new pool (or back to a
+ * singleton), so the cost scales with the smaller fragments rather than the
+ * whole pool. Geometric properties and adjacency links of every touched
+ * pool are refreshed; neighbor lists are left to the caller.
+ *
+ * @param manager The pool manager.
+ * @param pool The pool that lost a tile.
+ * @param removed_cell The cell the tile was removed from.
+ * @param geometry_type Grid geometry for neighbor calculations.
+ * @param board_tiles All tiles on the board, for the adjacency graph.
+ * @return The number of new pools created.
+ */
+size_t pool_manager_split_pool(pool_manager_t *manager, pool_t *pool,
+                               grid_cell_t removed_cell,
+                               grid_type_e geometry_type,
+                               const tile_map_t *board_tiles);
+
 /**
  * @brief Finds all pools compatible with the given tile based on its neighbors.
  * @param manager The pool manager.
@@ -75,7 +128,8 @@ void pool_manager_find_compatible_pools(pool_manager_t *manager, tile_t *tile,
 /**
  * @brief Assigns a tile to the appropriate pool or creates a new one.
  * @param manager The pool manager.
- * @param tile The tile to assign.
+ * @param tile The tile to assign; its same_type_mask must be current, as
+ *             board_add_tile leaves it.
  * @param geometry_type Grid geometry for neighbor calculations.
  * @param board_tiles All tiles on the board.
  * @return The pool the tile was assigned to, or NULL if singleton.
@@ -83,6 +137,29 @@ void pool_manager_find_compatible_pools(pool_manager_t *manager, tile_t *tile,
 pool_t *pool_manager_assign_tile(pool_manager_t *manager, tile_t *tile,
                                  grid_type_e geometry_type, tile_map_t *board_tiles);
 
+/**
+ * @brief Assigns a connected group of unpooled same-type tiles in one step.
+ *
+ * The pools in 'pool_ids' are the ones the group touches; they are merged
+ * (the largest survives) and the whole group joins the survivor, whose
+ * derived data is refreshed once. A group touching no pool gets a new pool
+ * if it has at least two tiles. The result matches assigning the tiles one
+ * by one with pool_manager_assign_tile.
+ *
+ * @param manager The pool manager.
+ * @param tiles The group; its neighbor masks must be current.
+ * @param count Number of tiles in the group.
+ * @param pool_ids Live pools of the group's type next to the group.
+ * @param pool_count Number of entries in 'pool_ids'.
+ * @param geometry_type Grid geometry for neighbor calculations.
+ * @param board_tiles All tiles on the board.
+ * @return The group's pool, or NULL if the single tile stays a singleton.
+ */
+pool_t *pool_manager_assign_group(pool_manager_t *manager, tile_t **tiles,
+                                  size_t count, const uint32_t *pool_ids,
+                                  size_t pool_count, grid_type_e geometry_type,
+                                  tile_map_t *board_tiles);
+
 /**
  * @brief Updates neighbor information for all pools affected by recent changes.
  * @param manager The pool manager.
@@ -108,4 +185,102 @@ void pool_manager_get_neighbor_pools(pool_manager_t *manager, grid_cell_t cell,
                                      grid_type_e geometry_type, tile_map_t *board_tiles,
                                      uint32_t *out_pool_ids, size_t *out_count);
 
+// --- Pool Adjacency Graph ---
+
+/**
+ * @brief Updates the adjacency graph for a tile that left 'from' and joined
+ * 'to'. Call it as each tile's membership changes, one tile at a time.
+ * Only the tile's other-type neighbors are visited, found through its
+ * neighbor masks, which must be current. Pool merges are handled by
+ * pool_track_merge and freed pools unlink themselves.
+ * @param manager The pool manager.
+ * @param tile The tile that moved.
+ * @param from The pool the tile left, or NULL if it was a singleton.
+ * @param to The pool the tile joined, or NULL if it became a singleton.
+ * @param geometry_type Grid geometry for neighbor calculations.
+ * @param board_tiles All tiles on the board.
+ */
+void pool_manager_track_tile_moved(pool_manager_t *manager, const tile_t *tile,
+                                   pool_t *from, pool_t *to,
+                                   grid_type_e geometry_type,
+                                   const tile_map_t *board_tiles);
+
+/**
+ * @brief Rebuilds the whole adjacency graph from the board, for pools that
+ * were assigned in bulk rather than tile by tile.
+ * @param manager The pool manager.
+ * @param geometry_type Grid geometry for neighbor calculations.
+ * @param board_tiles All tiles on the board.
+ */
+void pool_manager_rebuild_adjacency(pool_manager_t *manager,
+                                    grid_type_e geometry_type,
+                                    const tile_map_t *board_tiles);
+
+/**
+ * @brief Lists the pools that touch a pool, in O(degree).
+ * @param manager The pool manager.
+ * @param pool_id The pool; ids of pools merged into it also work.
+ * @param type Only pools of this tile type; TILE_UNDEFINED for any.
+ * @param out_pools Output array, or NULL to only count.
+ * @param max_pools Capacity of 'out_pools'.
+ * @return Number of matching pools; may exceed 'max_pools'.
+ */
+size_t pool_manager_get_adjacent_pools(pool_manager_t *manager,
+                                       uint32_t pool_id, tile_type_t type,
+                                       pool_t **out_pools, size_t max_pools);
+
+// --- Pool Leaderboard ---
+
+/**
+ * @brief Refreshes a pool's score and moves it to its place in the
+ * leaderboard, in O(log n). The manager calls this itself when it changes a
+ * pool's tiles or modifier.
+ * @param manager The pool manager.
+ * @param pool A live pool of the manager.
+ */
+void pool_manager_update_score(pool_manager_t *manager, pool_t *pool);
+
+/**
+ * @brief Sets a pool's modifier and moves the pool to its new place in the
+ * leaderboard.
+ * @param manager The pool manager.
+ * @param pool A live pool of the manager.
+ * @param modifier Modifier value (can be negative or positive).
+ */
+void pool_manager_set_pool_modifier(pool_manager_t *manager, pool_t *pool,
+                                    float modifier);
+
+/**
+ * @brief Adds to a pool's modifier and moves the pool to its new place in
+ * the leaderboard.
+ * @param manager The pool manager.
+ * @param pool A live pool of the manager.
+ * @param modifier_delta Value to add to the current modifier.
+ */
+void pool_manager_add_pool_modifier(pool_manager_t *manager, pool_t *pool,
+                                    float modifier_delta);
+
+/**
+ * @brief Refreshes every pool's score and rebuilds the leaderboard in O(n),
+ * for pools that were filled in bulk.
+ * @param manager The pool manager.
+ */
+void pool_manager_rebuild_leaderboard(pool_manager_t *manager);
+
+/**
+ * @brief Lists the highest scoring pools, best first, without sorting the
+ * rest. Costs O(k log k) for k results.
+ * @param manager The pool manager.
+ * @param out_pools Output array.
+ * @param max_pools Number of pools wanted; capacity of 'out_pools'.
+ * @return Number of pools written.
+ */
+size_t pool_manager_top_pools(pool_manager_t *manager, pool_t **out_pools,
+                              size_t max_pools);
+
+/**
+ * @brief Returns the highest scoring pool in O(1), or NULL if there is none.
+ */
+pool_t *pool_manager_best_pool(const pool_manager_t *manager);
+
 #endif /* pool_manager_H */
@@ -39,8 +39,37 @@ typedef struct {
     grid_cell_t cell;    // The cell this tile occupies. Crucially, this will be our hash key.
     tile_data_t data;    // Any specific value for the tile (e.g., resource amount).
     uint32_t pool_id;    // ID of the pool this tile belongs to
+    uint32_t store_index; // Row of this tile in its board's tile_store_t
+    uint32_t visit_epoch; // Last board traversal that visited this tile
+    uint8_t neighbor_mask;  // Bit d: the neighbor in direction d holds a tile
+    uint8_t same_type_mask; // Bit d: that neighbor has this tile's type
 } tile_t;
 
+// Bits used by the neighbor masks, one per hex direction
+#define TILE_MAX_NEIGHBORS 6
+
+/**
+ * @brief Counts the set bits of a neighbor mask.
+ */
+static inline int tile_mask_count(uint8_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= (uint8_t)(mask - 1))
+        count++;
+    return count;
+#endif
+}
+
+/**
+ * @brief Number of neighbors holding a tile of the same type, from the
+ * cached mask. The board keeps the masks current on placement and removal.
+ */
+static inline int tile_same_type_neighbor_count(const tile_t *tile) {
+    return tile_mask_count(tile->same_type_mask);
+}
+
 /**
  * @brief Creates and initializes a new tile_t object.
  * @param cell The grid cell where the tile is located.
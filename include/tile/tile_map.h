@@ -5,39 +5,123 @@
 #include "grid/grid_types.h"
 #include "tile.h"
 #include "third_party/kvec.h"
+#include "utility/slab.h"
+#include <stdint.h>
+
+/**
+ * @brief Packed, padding-free hash key for a grid cell.
+ * Axial q lives in the high 32 bits and r in the low 32 bits. The cube
+ * coordinate s is implied by q + r + s == 0, so it is not part of the key.
+ */
+typedef uint64_t tile_map_key_t;
 
 /**
  * @brief Individual Hash Table Entry
- * 'cell' is the key, and 'tile' is the associated value.
+ * 'key' is the packed form of 'cell', and 'tile' is the associated value.
  */
 typedef struct tile_map_entry {
-    grid_cell_t cell;      /* Key: grid cell coordinates */
+    tile_map_key_t key;    /* Key: packed axial coordinates of 'cell' */
+    grid_cell_t cell;      /* Grid cell coordinates */
     tile_t *tile;          /* Value: pointer to a tile */
     UT_hash_handle hh;     /* UTHash handle (must be last) */
 } tile_map_entry_t;
 
+/**
+ * @brief Storage strategy behind a tile map.
+ */
+typedef enum {
+    TILE_MAP_BACKEND_HASH,  /* Sparse uthash table (inventory pieces, pools) */
+    TILE_MAP_BACKEND_DENSE  /* Flat array over a bounded radius (main boards) */
+} tile_map_backend_e;
+
+/**
+ * @brief Order in which a dense map lays out (and iterates) its slots.
+ */
+typedef enum {
+    TILE_MAP_ORDER_ROWS,  /* Row-major: (r + radius) * stride + (q + radius) */
+    TILE_MAP_ORDER_MORTON /* Z-order curve over (q + radius, r + radius) */
+} tile_map_order_e;
+
 /**
  * @brief Tile Map Container
  * This struct encapsulates the hash root and additional metadata.
+ * Dense maps index 'cells' by axial offset, either row-major or along a Morton
+ * curve (see tile_map_order_e).
  */
 typedef struct tile_map {
-    tile_map_entry_t *root;
-    int num_tiles;         /* Total number of tiles in the map */
+    tile_map_backend_e backend;
+    tile_map_entry_t *root; /* Hash backend: uthash root */
+    tile_t **cells;         /* Dense backend: one slot per axial (q, r) */
+    int radius;             /* Dense backend: largest |q|, |r|, |s| stored */
+    int stride;             /* Dense backend: row length, 2 * radius + 1 */
+    tile_map_order_e order; /* Dense backend: slot layout */
+    int slot_count;         /* Dense backend: length of 'cells' */
+    int *stencil_deltas;    /* Dense row-major backend: slot delta of each
+                               hex_stencil_offsets entry */
+    int num_tiles;          /* Total number of tiles in the map */
+    slab_t *entry_slab;     /* Hash backend: storage for entries */
+    slab_t *tile_slab;      /* Tiles copied in by clone/merge, owned by the map */
 } tile_map_t;
 
+/**
+ * @brief Iterator over the tiles of a map, for either backend.
+ * Removing the tile last returned by the iterator is safe.
+ */
+typedef struct {
+    const tile_map_t *map;
+    tile_map_entry_t *next_entry; /* Hash backend: entry to visit next */
+    int next_index;               /* Dense backend: slot to visit next */
+} tile_map_iter_t;
+
+/* Iterate every tile of 'map'. 'tile' and 'iter' must be declared by the caller. */
+#define TILE_MAP_ITER(map, tile, iter)                                        \
+    for (tile_map_iter_init(&(iter), (map));                                  \
+         ((tile) = tile_map_iter_next(&(iter))) != NULL;)
+
 /* Function declarations */
 
+/* Interleave the bits of two 16-bit coordinates (Morton / Z-order code). */
+uint32_t tile_map_morton_encode(uint32_t x, uint32_t y);
+
+/**
+ * @brief Reorders a hash map's iteration along a Morton curve over (q, r).
+ * Dense maps already iterate in their slot order and are left untouched.
+ */
+void tile_map_sort_spatial(tile_map_t *map);
+
+/* Pack a cell into its canonical hash key. */
+tile_map_key_t tile_map_key_from_cell(grid_cell_t cell);
+
 /* Create a new tile map. */
 tile_map_t *tile_map_create(void);
 
+/* Create a dense tile map covering every cell within 'radius' of the origin. */
+tile_map_t *tile_map_create_dense(int radius);
+
+/**
+ * @brief Create a dense tile map with a chosen slot layout.
+ * Morton order keeps cells that are close on the board close in memory in
+ * both axes, at the cost of padding the slot array to a power-of-two square.
+ */
+tile_map_t *tile_map_create_dense_ordered(int radius, tile_map_order_e order);
+
+/* Create an empty tile map with the same backend (and layout) as 'source'. */
+tile_map_t *tile_map_create_like(const tile_map_t *source);
+
 /* Free the entire tile map. */
 void tile_map_free(tile_map_t *map);
 
-/* Find an entry in the tile map based on a grid cell key. */
-tile_map_entry_t* tile_map_find(const tile_map_t *map, grid_cell_t cell);
+/* Get the tile stored at a cell, or NULL if the cell is empty. */
+tile_t *tile_map_get(const tile_map_t *map, grid_cell_t cell);
 
 bool tile_map_contains(const tile_map_t *map, grid_cell_t cell);
 
+/* Whether the map is able to store a tile at 'cell' (always true for hash maps). */
+bool tile_map_in_bounds(const tile_map_t *map, grid_cell_t cell);
+
+/* Slot index of 'cell' in a dense map, or -1 if outside its radius. */
+int tile_map_dense_index(const tile_map_t *map, grid_cell_t cell);
+
 int tile_map_size(const tile_map_t *map);
 
 /* Remove an entry identified by a cell from the map. */
@@ -49,15 +133,111 @@ void tile_map_add(tile_map_t *map, tile_t *tile);
 /* Add a tile into the map without checking for existing entry (faster for batch operations). */
 void tile_map_add_unchecked(tile_map_t *map, tile_t *tile);
 
+/**
+ * @brief Adds many tiles whose cells are distinct and not yet in the map.
+ * Entry storage and the hash table are sized once for the whole batch, so
+ * the inserts never trigger incremental bucket expansion.
+ * @param map The tile map to add to.
+ * @param tiles Array of tiles; NULL elements are skipped.
+ * @param count Number of elements in 'tiles'.
+ * @return True on success, false on memory allocation failure, in which
+ * case the map is left as it was.
+ */
+bool tile_map_add_bulk(tile_map_t *map, tile_t *const *tiles, size_t count);
+
+/**
+ * @brief Builds a hash tile map from an array of tiles with distinct cells.
+ * @param tiles Array of tiles; NULL elements are skipped.
+ * @param count Number of elements in 'tiles'.
+ * @return The new map, or NULL on memory allocation failure.
+ */
+tile_map_t *tile_map_build_bulk(tile_t *const *tiles, size_t count);
+
+/**
+ * @brief Collects the tiles within 'range' of 'center', in stencil order:
+ * the center first, then ring by ring (see hex_stencil.h).
+ * Row-major dense maps read cells whose whole range lies inside the map with
+ * fixed slot deltas; other cells and maps look up each offset.
+ * @param map The tile map to search.
+ * @param center The center cell.
+ * @param range Largest distance from the center; ranges above
+ *        HEX_STENCIL_MAX_RADIUS walk their rings directly.
+ * @param out_tiles Output for the tiles found; must hold
+ *        HEX_STENCIL_COUNT(range) pointers.
+ * @return Number of tiles written to 'out_tiles'.
+ */
+size_t tile_map_collect_range(const tile_map_t *map, grid_cell_t center,
+                              int range, tile_t **out_tiles);
+
+/**
+ * @brief Counts the tiles of one type within 'range' of 'center', not
+ * counting the center itself.
+ * @param type Tile type to count, or a negative value to count every tile.
+ * Other parameters are as for tile_map_collect_range.
+ * @return Number of matching tiles.
+ */
+int tile_map_count_range(const tile_map_t *map, grid_cell_t center, int range,
+                         int type);
+
 /* Iterate over each tile map entry. */
 void tile_map_foreach_tile(tile_map_t *map, void (*fn)(tile_t *, void *),
                            void *user_data);
 
+/* Start iterating over the tiles of a map. */
+void tile_map_iter_init(tile_map_iter_t *iter, const tile_map_t *map);
+
+/* Next tile of the iteration, or NULL when done. */
+tile_t *tile_map_iter_next(tile_map_iter_t *iter);
+
+/**
+ * @brief Affine hex transform: rotate about 'center', then translate.
+ * Every such transform is a bijection on cells, so applying it to a map can
+ * never make two tiles collide.
+ */
+typedef struct {
+    int rotation_steps; /* 60-degree clockwise steps about 'center' */
+    grid_cell_t center; /* Pivot of the rotation */
+    grid_cell_t offset; /* Translation applied after the rotation */
+} tile_map_transform_t;
+
+/* Transform that rotates by 'rotation_steps' about 'center'. */
+tile_map_transform_t tile_map_transform_rotation(grid_cell_t center,
+                                                 int rotation_steps);
+
+/* Transform that translates by 'offset'. */
+tile_map_transform_t tile_map_transform_translation(grid_cell_t offset);
+
+/* Image of 'cell' under 'transform'. */
+grid_cell_t tile_map_transform_cell(const tile_map_transform_t *transform,
+                                    grid_cell_t cell);
+
+/**
+ * @brief Moves every tile of the map by an affine hex transform.
+ * Updates each tile's cell and rebuilds the index into a fresh table in one
+ * O(n) pass; no pairwise conflict check is needed.
+ * @param tile_map The tile map to transform.
+ * @param transform The transform to apply.
+ * @return True on success, false on memory allocation failure or if a tile
+ *         would leave a dense map's radius (the map is then unchanged).
+ */
+bool tile_map_transform(tile_map_t *tile_map,
+                        const tile_map_transform_t *transform);
+
+/**
+ * @brief Rebuilds the map's index from the current cells of its tiles.
+ * Use this on maps that share tiles with one that was just transformed.
+ * @param tile_map The tile map to re-index.
+ * @return True on success, false on memory allocation failure or if a tile
+ *         lies outside a dense map's radius (the map is then unchanged).
+ */
+bool tile_map_reindex(tile_map_t *tile_map);
+
 /**
  * @brief Applies an offset to all tiles in the tile map.
  * @param tile_map The tile map to offset.
  * @param offset The offset to apply to all tile coordinates.
- * @return True if offset was successful, false on memory allocation failure.
+ * @return True if offset was successful, false on memory allocation failure
+ *         or if a tile would leave a dense map's radius.
  */
 bool tile_map_apply_offset(tile_map_t *tile_map, grid_cell_t offset);
 
@@ -66,7 +246,8 @@ bool tile_map_apply_offset(tile_map_t *tile_map, grid_cell_t offset);
  * @param tile_map The tile map to rotate.
  * @param center The center point to rotate around.
  * @param rotation_steps Number of 60-degree clockwise rotation steps (0-5).
- * @return True if rotation was successful, false on memory allocation failure.
+ * @return True if rotation was successful, false on memory allocation failure
+ *         or if a tile would leave a dense map's radius.
  */
 bool tile_map_rotate(tile_map_t *tile_map, grid_cell_t center, int rotation_steps);
 
@@ -76,6 +257,7 @@ bool tile_map_rotate(tile_map_t *tile_map, grid_cell_t center, int rotation_step
  * @param source The source tile map to merge from.
  * @return True if merge was successful, false if any conflicts or memory allocation failed.
  * @note Source tile map is not modified. Conflicting positions will cause merge to fail.
+ * @note The copied tiles are owned by 'dest' and released by tile_map_free.
  * @note Use tile_map_apply_offset on source before merging if offset is needed.
  */
 bool tile_map_merge(tile_map_t *dest, const tile_map_t *source);
@@ -84,7 +266,8 @@ bool tile_map_merge(tile_map_t *dest, const tile_map_t *source);
  * @brief Creates a deep copy of a tile map.
  * @param source The source tile map to clone.
  * @return A new tile map containing copies of all tiles from source, or NULL on failure.
- * @note Caller is responsible for freeing the returned tile map.
+ * @note Caller is responsible for freeing the returned tile map; the copied
+ *       tiles are owned by the clone and released with it.
  */
 tile_map_t *tile_map_clone(const tile_map_t *source);
 
@@ -110,6 +293,8 @@ bool tile_map_find_overlaps(const tile_map_t *map1, const tile_map_t *map2,
  * @return True if successful, false on memory allocation failure.
  * @note Caller is responsible for freeing the allocated array.
  * @note Only reports positions that would overlap between the two tile maps.
+ * @note Looks up each source tile in 'dest'. Boards answer the same question
+ * from their occupancy bitboards; see bitboard_count_overlap.
  */
 bool tile_map_find_merge_conflicts(const tile_map_t *source, const tile_map_t *dest,
                                   grid_cell_t offset, grid_cell_t **out_conflicts,
@@ -121,6 +306,8 @@ bool tile_map_find_merge_conflicts(const tile_map_t *source, const tile_map_t *d
  * @param dest The destination tile map to check against.
  * @param offset The offset to apply to source tiles before checking.
  * @return True if merge is valid (no overlapping positions), false otherwise.
+ * @note Looks up each source tile in 'dest'. Boards answer the same question
+ * from their occupancy bitboards; see bitboard_count_overlap.
  */
 bool tile_map_can_merge_with_offset(const tile_map_t *source, const tile_map_t *dest,
                                     grid_cell_t offset);
@@ -0,0 +1,98 @@
+/**************************************************************************//**
+ * @file tile_store.h
+ * @brief Structure-of-arrays copy of a board's tile data for bulk kernels.
+ *****************************************************************************/
+
+#ifndef TILE_STORE_H
+#define TILE_STORE_H
+
+#include "tile.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Parallel columns holding one row per tile on a board.
+ *
+ * Rows are appended when a tile is placed and swap-removed when it leaves,
+ * with tile->store_index tracking each tile's row. Tile data does not change
+ * after creation, so those columns are written once. Pool membership changes
+ * all over the pool code, so the pool_ids column is refreshed from the tiles
+ * in one pass the next time a pool kernel runs after it was marked dirty.
+ */
+typedef struct tile_store {
+    int32_t *types;      /* tile_type_t of each row */
+    int32_t *values;     /* Base value of each row */
+    float *modifiers;    /* Production multiplier of each row */
+    uint32_t *pool_ids;  /* Pool of each row (see pool_ids_dirty) */
+    tile_t **tiles;      /* Tile each row mirrors */
+    size_t count;
+    size_t capacity;
+    bool pool_ids_dirty; /* pool_ids must be refreshed before use */
+} tile_store_t;
+
+/**
+ * @brief Production totals for a set of tiles.
+ */
+typedef struct {
+    float total;                    /* Sum over every tile */
+    float by_type[TILE_TYPE_COUNT]; /* Sum over the tiles of each type */
+} tile_store_production_t;
+
+/**
+ * @brief Creates an empty tile store.
+ * @return Pointer to the new store, or NULL on allocation failure.
+ */
+tile_store_t *tile_store_create(void);
+
+/**
+ * @brief Frees the store and its columns.
+ * @param store The store to free; NULL is ignored.
+ */
+void tile_store_free(tile_store_t *store);
+
+/**
+ * @brief Removes every row, keeping the allocated columns.
+ * @param store The store to clear.
+ */
+void tile_store_clear(tile_store_t *store);
+
+/**
+ * @brief Appends a row for 'tile' and records its index in the tile.
+ * @param store The store to append to.
+ * @param tile The tile to mirror.
+ * @return True on success, false on allocation failure.
+ */
+bool tile_store_add(tile_store_t *store, tile_t *tile);
+
+/**
+ * @brief Removes the row of 'tile', moving the last row into its place.
+ * @param store The store holding the tile.
+ * @param tile The tile to remove; ignored if it has no row in the store.
+ */
+void tile_store_remove(tile_store_t *store, tile_t *tile);
+
+/**
+ * @brief Copies each tile's current pool id into the pool_ids column.
+ * @param store The store to refresh.
+ */
+void tile_store_sync_pool_ids(tile_store_t *store);
+
+/**
+ * @brief Sums value * modifier over every row, overall and per tile type.
+ * @param store The store to sum.
+ * @param out Output totals.
+ */
+void tile_store_sum_production(const tile_store_t *store,
+                               tile_store_production_t *out);
+
+/**
+ * @brief Sums value * modifier over the rows belonging to one pool.
+ * Refreshes the pool_ids column first if it is dirty.
+ * @param store The store to sum.
+ * @param pool_id The pool to sum; 0 sums the singleton tiles.
+ * @return The pool's production.
+ */
+float tile_store_pool_production(tile_store_t *store, uint32_t pool_id);
+
+#endif // TILE_STORE_H
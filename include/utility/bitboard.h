@@ -0,0 +1,84 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "grid/grid_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Packed occupancy bits for every hex cell within a radius.
+ *
+ * Cells are laid out in rows of constant r, one bit per column q + radius.
+ * Each row starts on a word boundary, so a translated piece can be tested
+ * against a board row by row with word-wise ANDs. 'valid' marks the cells
+ * that lie inside the hexagon; the rhombus corners outside it stay zero.
+ */
+typedef struct bitboard {
+    int radius;
+    int stride;         /* Columns per row, 2 * radius + 1 */
+    int words_per_row;  /* 64-bit words per row */
+    uint64_t *occupied; /* One bit per occupied cell */
+    uint64_t *valid;    /* One bit per cell inside the radius */
+    int count;          /* Number of occupied cells */
+} bitboard_t;
+
+/**
+ * @brief Creates an empty bitboard covering every cell within 'radius'.
+ * @param radius The hex radius around the origin.
+ * @return Pointer to the new bitboard, or NULL on failure.
+ */
+bitboard_t *bitboard_create(int radius);
+
+/**
+ * @brief Frees a bitboard.
+ * @param bitboard The bitboard to free; NULL is ignored.
+ */
+void bitboard_free(bitboard_t *bitboard);
+
+/**
+ * @brief Clears every occupied bit.
+ * @param bitboard The bitboard to clear.
+ */
+void bitboard_clear(bitboard_t *bitboard);
+
+/**
+ * @brief Checks whether a cell lies within the bitboard's radius.
+ */
+bool bitboard_in_bounds(const bitboard_t *bitboard, grid_cell_t cell);
+
+/**
+ * @brief Checks whether a cell is occupied.
+ * @return True if the cell is in bounds and occupied.
+ */
+bool bitboard_test(const bitboard_t *bitboard, grid_cell_t cell);
+
+/**
+ * @brief Marks a cell occupied.
+ * @return True on success, false if the cell is outside the radius.
+ */
+bool bitboard_set(bitboard_t *bitboard, grid_cell_t cell);
+
+/**
+ * @brief Marks a cell empty. Cells outside the radius are ignored.
+ */
+void bitboard_reset(bitboard_t *bitboard, grid_cell_t cell);
+
+/**
+ * @brief Counts the overlap of a translated piece with a board.
+ *
+ * Each occupied piece cell is moved by 'offset'. Pieces are compared one
+ * row at a time: a 64-cell window of the board row is ANDed with the piece
+ * word and the result is popcounted.
+ *
+ * @param board The bitboard being placed onto.
+ * @param piece The bitboard of the piece being placed.
+ * @param offset Translation applied to every piece cell.
+ * @param out_of_bounds Optional output: piece cells that land outside the
+ *                      board's radius.
+ * @return Number of piece cells that land on occupied board cells.
+ */
+size_t bitboard_count_overlap(const bitboard_t *board, const bitboard_t *piece,
+                              grid_cell_t offset, size_t *out_of_bounds);
+
+#endif // BITBOARD_H
@@ -0,0 +1,60 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Union-find forest over dense element ids.
+ *
+ * Elements are numbered 0, 1, 2, ... in the order they are made. Unions link
+ * the root of the smaller set under the root of the larger one and finds
+ * halve the path they walk, so any sequence of operations runs in nearly
+ * constant amortized time per call.
+ */
+typedef struct disjoint_set {
+    uint32_t *parent; /* Parent of each element; roots point to themselves */
+    uint32_t *size;   /* Element count of each root's set */
+    size_t count;     /* Number of elements made so far */
+    size_t capacity;
+} disjoint_set_t;
+
+/**
+ * @brief Creates an empty forest.
+ * @return Pointer to the new forest, or NULL on allocation failure.
+ */
+disjoint_set_t *disjoint_set_create(void);
+
+/**
+ * @brief Frees a forest.
+ * @param set The forest to free; NULL is ignored.
+ */
+void disjoint_set_free(disjoint_set_t *set);
+
+/**
+ * @brief Adds a new element in a set of its own.
+ * @param set The forest to extend.
+ * @param out_id Output: the new element's id.
+ * @return True on success, false on allocation failure.
+ */
+bool disjoint_set_make(disjoint_set_t *set, uint32_t *out_id);
+
+/**
+ * @brief Finds the representative of an element's set.
+ * @param set The forest to search.
+ * @param id The element; ids that were never made are returned unchanged.
+ * @return The root element of the set containing 'id'.
+ */
+uint32_t disjoint_set_find(disjoint_set_t *set, uint32_t id);
+
+/**
+ * @brief Joins the sets containing 'a' and 'b'.
+ * @param set The forest to update.
+ * @param a An element of the first set.
+ * @param b An element of the second set.
+ * @return The root of the joined set. Ties keep the root of 'a'.
+ */
+uint32_t disjoint_set_union(disjoint_set_t *set, uint32_t a, uint32_t b);
+
+#endif // DISJOINT_SET_H
@@ -0,0 +1,73 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Fixed-size object allocator.
+ *
+ * Objects are carved out of large chunks and recycled through an intrusive
+ * free list, so allocating and releasing an object never touches malloc once
+ * a chunk is available. Resetting or destroying the slab releases every
+ * object at once with one operation per chunk.
+ */
+typedef struct slab_chunk slab_chunk_t;
+
+typedef struct slab {
+    size_t object_size;      /* Size of each object, rounded up for alignment */
+    size_t objects_per_chunk;
+    slab_chunk_t *chunks;    /* Most recently allocated chunk first */
+    size_t chunk_capacity;   /* Objects the head chunk holds */
+    size_t chunk_used;       /* Objects handed out from the head chunk */
+    void *free_list;         /* Released objects available for reuse */
+    size_t live_count;       /* Objects currently allocated */
+} slab_t;
+
+/**
+ * @brief Creates a slab for objects of a given size.
+ * @param object_size Size in bytes of each object.
+ * @param objects_per_chunk Number of objects carved from each chunk.
+ * @return Pointer to the new slab, or NULL on allocation failure.
+ */
+slab_t *slab_create(size_t object_size, size_t objects_per_chunk);
+
+/**
+ * @brief Allocates one object from the slab.
+ * @param slab The slab to allocate from.
+ * @return Pointer to uninitialized storage, or NULL on allocation failure.
+ */
+void *slab_alloc(slab_t *slab);
+
+/**
+ * @brief Makes room for 'count' more objects in one contiguous chunk.
+ * If the head chunk is too small, a chunk of exactly max(count,
+ * objects_per_chunk) objects becomes the new head; the old head's unused
+ * tail is left for slab_reset. Chunks allocated later are back to
+ * objects_per_chunk, so one large reserve does not size every later chunk.
+ * @param slab The slab to reserve in.
+ * @param count Number of objects about to be allocated.
+ * @return False on allocation failure.
+ */
+bool slab_reserve(slab_t *slab, size_t count);
+
+/**
+ * @brief Returns an object to the slab's free list.
+ * @param slab The slab the object was allocated from.
+ * @param object The object to release; NULL is ignored.
+ */
+void slab_release(slab_t *slab, void *object);
+
+/**
+ * @brief Releases every object while keeping the first chunk for reuse.
+ * @param slab The slab to reset.
+ */
+void slab_reset(slab_t *slab);
+
+/**
+ * @brief Frees the slab and all of its chunks.
+ * @param slab The slab to destroy; NULL is ignored.
+ */
+void slab_destroy(slab_t *slab);
+
+#endif // SLAB_H
@@ -1,6 +1,10 @@
 #include "game/board.h"
+#include "game/board_labeling.h"
+#include "game/board_traversal.h"
 #include "game/camera.h"
+#include "grid/grid_cell_utils.h"
 #include "grid/grid_geometry.h"
+#include "grid/hex_kernels.h"
 #include "third_party/uthash.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,6 +13,9 @@
 
 #define MAX_POOL_CANDIDATES 10
 
+// Upper bound on tiles per slab chunk; smaller boards size chunks to fit
+#define BOARD_TILE_SLAB_MAX_CHUNK 4096
+
 // Temporary hex edge definitions until we have a better solution
 typedef enum {
     HEX_EDGE_E = 0,  // East
@@ -44,25 +51,149 @@ static void create_center_cluster(board_t *board) {
     tile_data_t cyan_data = tile_data_create(TILE_CYAN, 1, 1.0);
     tile_data_t yellow_data = tile_data_create(TILE_YELLOW, 1, 1.0);
 
-    tile_t *center_tile = tile_create_ptr(center, magenta_data);
-    center_tile->pool_id = 0;
+    tile_t *center_tile = board_create_tile(board, center, magenta_data);
     board_add_tile(board, center_tile);
 
     // Get the first two neighbors for the other colors
     int neighbor_count = grid_geometry_get_neighbor_count(board->geometry_type);
     grid_cell_t neighbor_cells[neighbor_count];
-    grid_geometry_get_all_neighbors(board->geometry_type, center_tile->cell,
-                                    neighbor_cells);
+    hex_kernel_grid_neighbors(board->geometry_type, center_tile->cell,
+                              neighbor_cells);
 
-    tile_t *neighbor1_tile = tile_create_ptr(neighbor_cells[0], cyan_data);
-    neighbor1_tile->pool_id = 0;
+    tile_t *neighbor1_tile =
+      board_create_tile(board, neighbor_cells[0], cyan_data);
     board_add_tile(board, neighbor1_tile);
 
-    tile_t *neighbor2_tile = tile_create_ptr(neighbor_cells[1], yellow_data);
-    neighbor2_tile->pool_id = 0;
+    tile_t *neighbor2_tile =
+      board_create_tile(board, neighbor_cells[1], yellow_data);
     board_add_tile(board, neighbor2_tile);
 }
 
+// One chunk holds every cell of a small board, so filling it is one malloc.
+static slab_t *board_create_tile_slab(int radius) {
+    size_t cell_count = 3 * (size_t)radius * (radius + 1) + 1;
+    if (cell_count > BOARD_TILE_SLAB_MAX_CHUNK)
+        cell_count = BOARD_TILE_SLAB_MAX_CHUNK;
+    return slab_create(sizeof(tile_t), cell_count);
+}
+
+// Main boards are bounded by their radius, so they index tiles directly by
+// cell; inventory pieces stay on the sparse hash backend.
+static tile_map_t *board_create_tile_map(const board_t *board) {
+    if (board->board_type == BOARD_TYPE_MAIN)
+        return tile_map_create_dense(board->radius);
+    return tile_map_create();
+}
+
+#define BOARD_EXTENT_BLOCK 64 // Tiles projected per batch
+
+// Whether the extent's projections were taken in the layout's orientation
+static bool board_extent_current(const board_t *board) {
+    const orientation_t *a = &board->extent.orientation;
+    const orientation_t *b = &board->layout.orientation;
+    return a->f0 == b->f0 && a->f1 == b->f1 && a->f2 == b->f2 &&
+           a->f3 == b->f3;
+}
+
+// Widens the extent to cover cells whose lattice projections are in 'xy'
+static void board_extent_include(board_extent_t *extent,
+                                 const grid_cell_t *cells, const float *xy,
+                                 size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float x = xy[2 * i];
+        float y = xy[2 * i + 1];
+        if (!extent->has_tiles) {
+            for (int k = 0; k < 4; k++) {
+                extent->cells[k] = cells[i];
+                extent->projections[k] = k % 2 == 0 ? x : y;
+            }
+            extent->has_tiles = true;
+            continue;
+        }
+        if (x < extent->projections[0]) {
+            extent->cells[0] = cells[i];
+            extent->projections[0] = x;
+        }
+        if (y < extent->projections[1]) {
+            extent->cells[1] = cells[i];
+            extent->projections[1] = y;
+        }
+        if (x > extent->projections[2]) {
+            extent->cells[2] = cells[i];
+            extent->projections[2] = x;
+        }
+        if (y > extent->projections[3]) {
+            extent->cells[3] = cells[i];
+            extent->projections[3] = y;
+        }
+    }
+}
+
+// Widens the extent to cover 'count' tiles; NULL entries are skipped
+static void board_extent_include_tiles(board_t *board, tile_t *const *tiles,
+                                       size_t count) {
+    layout_t lattice = {.orientation = board->extent.orientation,
+                        .size = {1.0, 1.0},
+                        .origin = {0.0, 0.0},
+                        .scale = 1.0};
+    grid_cell_t cells[BOARD_EXTENT_BLOCK];
+    float xy[2 * BOARD_EXTENT_BLOCK];
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (tiles[i])
+            cells[n++] = tiles[i]->cell;
+        if (n == BOARD_EXTENT_BLOCK || (i + 1 == count && n > 0)) {
+            grid_geometry_cells_to_pixels(board->geometry_type, &lattice,
+                                          cells, n, xy);
+            board_extent_include(&board->extent, cells, xy, n);
+            n = 0;
+        }
+    }
+}
+
+// Recomputes the extent from every tile on the board
+static void board_extent_rebuild(board_t *board) {
+    board->extent.has_tiles = false;
+    board->extent.orientation = board->layout.orientation;
+    tile_t *block[BOARD_EXTENT_BLOCK];
+    size_t n = 0;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        block[n++] = tile;
+        if (n == BOARD_EXTENT_BLOCK) {
+            board_extent_include_tiles(board, block, n);
+            n = 0;
+        }
+    }
+    board_extent_include_tiles(board, block, n);
+}
+
+// Keeps the extent valid after 'count' tiles joined the board's tile map
+static void board_extent_add_tiles(board_t *board, tile_t *const *tiles,
+                                   size_t count) {
+    if (!board->extent.has_tiles)
+        board->extent.orientation = board->layout.orientation;
+    else if (!board_extent_current(board)) {
+        board_extent_rebuild(board);
+        return;
+    }
+    board_extent_include_tiles(board, tiles, count);
+}
+
+// Keeps the extent valid after the tile at 'cell' left the board. Only a
+// tile that bounds the board forces a rescan.
+static void board_extent_remove_cell(board_t *board, grid_cell_t cell) {
+    if (!board->extent.has_tiles)
+        return;
+    bool rescan = !board_extent_current(board);
+    for (int k = 0; k < 4 && !rescan; k++) {
+        rescan = grid_cells_equal(&board->extent.cells[k], &cell);
+    }
+    if (rescan)
+        board_extent_rebuild(board);
+}
+
 board_t *board_create(grid_type_e grid_type, int radius,
                       board_type_e board_type) {
     board_t *board = malloc(sizeof(board_t));
@@ -91,8 +222,14 @@ board_t *board_create(grid_type_e grid_type, int radius,
         free(board);
         return NULL;
     }
-
-    board->tiles = tile_map_create();
+    grid_geometry_update_layout(grid_type, &board->layout);
+
+    board->tiles = board_create_tile_map(board);
+    board->tile_slab = board_create_tile_slab(radius);
+    board->store = tile_store_create();
+    board->occupancy = bitboard_create(radius);
+    board->extent.has_tiles = false;
+    board->traversal = board_traversal_create();
     board->pools = pool_manager_create();
     board->next_pool_id = 1;
 
@@ -108,7 +245,11 @@ board_t *board_create(grid_type_e grid_type, int radius,
 void clear_board(board_t *board) {
     tile_map_free(board->tiles);
     pool_manager_free(board->pools);
-    board->tiles = tile_map_create();
+    slab_reset(board->tile_slab);
+    tile_store_clear(board->store);
+    bitboard_clear(board->occupancy);
+    board->extent.has_tiles = false;
+    board->tiles = board_create_tile_map(board);
     board->pools = pool_manager_create();
     board->next_pool_id = 1;
 }
@@ -116,9 +257,23 @@ void clear_board(board_t *board) {
 void free_board(board_t *board) {
     tile_map_free(board->tiles);
     pool_manager_free(board->pools);
+    slab_destroy(board->tile_slab);
+    tile_store_free(board->store);
+    bitboard_free(board->occupancy);
+    board_traversal_free(board->traversal);
     free(board);
 }
 
+tile_t *board_create_tile(board_t *board, grid_cell_t cell, tile_data_t data) {
+    tile_t *tile = slab_alloc(board->tile_slab);
+    if (!tile)
+        return NULL;
+    // Slab memory is recycled by clear_board, so reset every field; the pool
+    // id and masks are assigned when the tile is added to the board
+    *tile = (tile_t){.cell = cell, .data = data};
+    return tile;
+}
+
 // Helper function to get tile from cell
 grid_cell_t board_pixel_to_cell(const board_t *board, point_t point) {
     return grid_geometry_pixel_to_cell(board->geometry_type, &board->layout,
@@ -126,8 +281,20 @@ grid_cell_t board_pixel_to_cell(const board_t *board, point_t point) {
 }
 
 tile_t *board_tile_at_cell(const board_t *board, grid_cell_t cell) {
-    tile_map_entry_t *entry = tile_map_find(board->tiles, cell);
-    return entry ? entry->tile : NULL;
+    return tile_map_get(board->tiles, cell);
+}
+
+bool board_is_occupied(const board_t *board, grid_cell_t cell) {
+    return bitboard_test(board->occupancy, cell);
+}
+
+int board_count_in_range(const board_t *board, grid_cell_t cell, int range,
+                         int type) {
+    return tile_map_count_range(board->tiles, cell, range, type);
+}
+
+bool board_cell_in_bounds(const board_t *board, grid_cell_t cell) {
+    return bitboard_in_bounds(board->occupancy, cell);
 }
 
 // Function to get neighboring pools that accept a specific tile type
@@ -135,8 +302,7 @@ void get_neighbor_pools(board_t *board, tile_t *tile, pool_t **out_pools,
                         size_t max_neighbors) {
     grid_cell_t neighbor_cells[6];
 
-    grid_geometry_get_all_neighbors(board->geometry_type, tile->cell,
-                                    neighbor_cells);
+    hex_kernel_grid_neighbors(board->geometry_type, tile->cell, neighbor_cells);
 
     for (size_t i = 0; i < max_neighbors; ++i) {
         tile_t *neighbor_tile = board_tile_at_cell(board, neighbor_cells[i]);
@@ -156,71 +322,207 @@ void get_neighbor_pools(board_t *board, tile_t *tile, pool_t **out_pools,
     }
 }
 
-void board_add_tile(board_t *board, tile_t *tile) {
+// Hex directions come in opposite pairs, three steps apart
+static int board_opposite_direction(int direction) {
+    return (direction + TILE_MAX_NEIGHBORS / 2) % TILE_MAX_NEIGHBORS;
+}
+
+// Sets a tile's same-type mask, moving the tile between its pool's
+// neighbor histogram buckets if the count changed
+static void board_set_same_type_mask(board_t *board, tile_t *tile,
+                                     uint8_t mask) {
+    if (tile->same_type_mask == mask)
+        return;
+    if (tile->pool_id != 0) {
+        pool_t *pool = pool_manager_get_pool(board->pools, tile->pool_id);
+        pool_track_neighbor_count_changed(pool,
+                                          tile_same_type_neighbor_count(tile),
+                                          tile_mask_count(mask));
+    }
+    tile->same_type_mask = mask;
+}
+
+// Recomputes a tile's own masks from the board, leaving its neighbors alone
+static void board_compute_neighbor_masks(const board_t *board, tile_t *tile) {
+    grid_cell_t neighbor_cells[TILE_MAX_NEIGHBORS];
+    hex_kernel_grid_neighbors(board->geometry_type, tile->cell, neighbor_cells);
+
+    tile->neighbor_mask = 0;
+    tile->same_type_mask = 0;
+    for (int d = 0; d < TILE_MAX_NEIGHBORS; d++) {
+        tile_t *neighbor = tile_map_get(board->tiles, neighbor_cells[d]);
+        if (!neighbor)
+            continue;
+        tile->neighbor_mask |= (uint8_t)(1u << d);
+        if (neighbor->data.type == tile->data.type)
+            tile->same_type_mask |= (uint8_t)(1u << d);
+    }
+}
+
+// Computes a placed tile's masks and sets the matching bits on its
+// neighbors. The tile itself must not be in a pool yet. The neighbor tiles
+// are returned in 'out_neighbors', NULL for empty cells.
+static void board_link_neighbor_masks(board_t *board, tile_t *tile,
+                                      tile_t **out_neighbors) {
+    grid_cell_t neighbor_cells[TILE_MAX_NEIGHBORS];
+    hex_kernel_grid_neighbors(board->geometry_type, tile->cell, neighbor_cells);
+
+    uint8_t occupied = 0;
+    uint8_t same_type = 0;
+    for (int d = 0; d < TILE_MAX_NEIGHBORS; d++) {
+        tile_t *neighbor = tile_map_get(board->tiles, neighbor_cells[d]);
+        if (out_neighbors)
+            out_neighbors[d] = neighbor;
+        if (!neighbor)
+            continue;
+        uint8_t back = (uint8_t)(1u << board_opposite_direction(d));
+        occupied |= (uint8_t)(1u << d);
+        neighbor->neighbor_mask |= back;
+        if (neighbor->data.type == tile->data.type) {
+            same_type |= (uint8_t)(1u << d);
+            board_set_same_type_mask(board, neighbor,
+                                     neighbor->same_type_mask | back);
+        } else {
+            board_set_same_type_mask(board, neighbor,
+                                     neighbor->same_type_mask & ~back);
+        }
+    }
+    tile->neighbor_mask = occupied;
+    tile->same_type_mask = same_type;
+}
+
+// Clears the bits that point at a removed tile from its neighbors' masks.
+// The neighbor tiles are returned in 'out_neighbors', NULL for empty cells.
+static void board_unlink_neighbor_masks(board_t *board, const tile_t *tile,
+                                        tile_t **out_neighbors) {
+    grid_cell_t neighbor_cells[TILE_MAX_NEIGHBORS];
+    hex_kernel_grid_neighbors(board->geometry_type, tile->cell, neighbor_cells);
+
+    for (int d = 0; d < TILE_MAX_NEIGHBORS; d++) {
+        tile_t *neighbor = tile_map_get(board->tiles, neighbor_cells[d]);
+        out_neighbors[d] = neighbor;
+        if (!neighbor)
+            continue;
+        uint8_t back = (uint8_t)(1u << board_opposite_direction(d));
+        neighbor->neighbor_mask &= ~back;
+        board_set_same_type_mask(board, neighbor,
+                                 neighbor->same_type_mask & ~back);
+    }
+}
+
+// A cell is on the frontier of exactly the pools next to it, so only the
+// pools of its neighbor tiles see their neighbor tiles change
+static void board_invalidate_neighbor_pools(board_t *board,
+                                            tile_t **neighbors) {
+    for (int d = 0; d < TILE_MAX_NEIGHBORS; d++) {
+        if (!neighbors[d] || neighbors[d]->pool_id == 0)
+            continue;
+        pool_t *pool =
+          pool_manager_get_pool(board->pools, neighbors[d]->pool_id);
+        if (pool)
+            pool_invalidate_neighbor_tiles(pool);
+    }
+}
+
+bool board_add_tile(board_t *board, tile_t *tile) {
+    // Cells outside the radius have no slot in the map or the bitboard, so
+    // reject them before any board state changes
+    if (!board || !tile || !board_cell_in_bounds(board, tile->cell))
+        return false;
+
+    // A tile placed over another one replaces it in the store as well
+    tile_t *replaced = tile_map_get(board->tiles, tile->cell);
+    if (replaced && replaced != tile) {
+        tile_store_remove(board->store, replaced);
+    }
+
     // Add tile to board's tile map first
     tile_map_add(board->tiles, tile);
+    if (replaced != tile) {
+        tile_store_add(board->store, tile);
+    }
+    bitboard_set(board->occupancy, tile->cell);
+    board_extent_add_tiles(board, &tile, 1);
+    board->store->pool_ids_dirty = true;
+    tile_t *neighbors[TILE_MAX_NEIGHBORS];
+    board_link_neighbor_masks(board, tile, neighbors);
 
     // Use pool_manager to assign the tile to appropriate pool
     pool_t *target_pool = pool_manager_assign_tile(
       board->pools, tile, board->geometry_type, board->tiles);
 
-    // Collect affected cells for neighbor updates
-    int neighbor_count = grid_geometry_get_neighbor_count(board->geometry_type);
-    grid_cell_t affected_cells[neighbor_count + 1];
-
-    // The tile's own cell is affected
-    affected_cells[0] = tile->cell;
-
-    // Add all neighbor cells as affected
-    grid_geometry_get_all_neighbors(board->geometry_type, tile->cell,
-                                    &affected_cells[1]);
-
-    // Update all pools that might be affected by this tile placement
-    pool_manager_update_affected_pools(board->pools, affected_cells,
-                                       neighbor_count + 1, board->geometry_type,
-                                       board->tiles);
+    // The tile's own pool tracked the change itself; the pools around it
+    // gained a neighbor tile
+    board_invalidate_neighbor_pools(board, neighbors);
+    return true;
 }
 
 void remove_tile(board_t *board, tile_t *tile) {
+    // Remove tile from board's tile map
+    tile_map_remove(board->tiles, tile->cell);
+    tile_store_remove(board->store, tile);
+    bitboard_reset(board->occupancy, tile->cell);
+    board_extent_remove_cell(board, tile->cell);
+    board->store->pool_ids_dirty = true;
+    tile_t *neighbors[TILE_MAX_NEIGHBORS];
+    board_unlink_neighbor_masks(board, tile, neighbors);
 
     // Get the pool this tile belongs to (only if tile has a pool)
     if (tile->pool_id != 0) {
         pool_manager_entry_t *pool_entry =
           pool_manager_find_by_id(board->pools, tile->pool_id);
         if (pool_entry) {
-            // Remove tile from pool
-            pool_remove_tile(pool_entry->pool, tile);
+            pool_t *pool = pool_entry->pool;
+
+            // Remove tile from pool, then split off any fragments it was
+            // holding together
+            pool_remove_tile(pool, tile, board->geometry_type);
+            pool_manager_track_tile_moved(board->pools, tile, pool, NULL,
+                                          board->geometry_type, board->tiles);
+            pool_manager_split_pool(board->pools, pool, tile->cell,
+                                    board->geometry_type, board->tiles);
 
             // Check if pool now has less than 2 tiles - if so, convert
             // remaining tiles to singletons
-            if (pool_entry->pool->tiles->num_tiles < 2) {
+            if (pool->tiles->num_tiles < 2) {
 
-                tile_map_entry_t *remaining_entry, *tmp;
-                HASH_ITER(hh, pool_entry->pool->tiles->root, remaining_entry,
-                          tmp) {
-                    remaining_entry->tile->pool_id = 0; // Convert to singleton
+                tile_map_iter_t iter;
+                tile_t *remaining_tile;
+                TILE_MAP_ITER(pool->tiles, remaining_tile, iter) {
+                    remaining_tile->pool_id = 0; // Convert to singleton
                 }
                 // Remove the now-empty pool
-                pool_manager_remove(board->pools, tile->pool_id);
-
-            } else {
-
-                // TODO: Fix pool_update to work without grid instance
-                // pool_update(pool_entry->pool, board->geometry_type,
-                // board->layout,
-                //             board->radius);
+                pool_manager_remove(board->pools, pool->id);
+                pool_free(pool);
             }
         }
     }
+    tile->neighbor_mask = 0;
+    tile->same_type_mask = 0;
 
-    // Remove tile from board's tile map
-    tile_map_remove(board->tiles, tile->cell);
+    // Every pool around the cell lost a neighbor tile
+    board_invalidate_neighbor_pools(board, neighbors);
 
     // Mark chunk dirty for rendering updates - DISABLED
     // chunk_id_t chunk_id = grid_get_chunk_id(board->grid, tile->cell);
     // grid_mark_chunk_dirty(board->grid, chunk_id);
 }
 
+void cycle_tile_type(board_t *board, tile_t *tile) {
+    if (!board || !tile || board_tile_at_cell(board, tile->cell) != tile)
+        return;
+
+    // Placing the tile again under its new type updates its neighbors'
+    // masks and moves it to the pool it now belongs to
+    remove_tile(board, tile);
+    int next_type = tile->data.type + 1;
+    if (next_type < TILE_MAGENTA || next_type >= TILE_TYPE_COUNT)
+        next_type = TILE_MAGENTA;
+    tile->data.type = (tile_type_t)next_type;
+    tile->pool_id = 0;
+    board_add_tile(board, tile);
+}
+
 void board_randomize(board_t *board, int radius, board_type_e board_type) {
     // Clamp radius to board's maximum radius
     if (radius > board->radius) {
@@ -246,15 +548,11 @@ void board_randomize(board_t *board, int radius, board_type_e board_type) {
         return;
     }
 
-    // Remove center coordinate from the list if we placed a center tile
+    // Remove the cells taken by the center cluster if we placed one
     if (board_type == BOARD_TYPE_MAIN) {
-        grid_cell_t center = grid_geometry_get_origin(board->geometry_type);
         size_t filtered_count = 0;
         for (size_t i = 0; i < coord_count; i++) {
-            bool is_center = (all_coords[i].coord.hex.q == center.coord.hex.q &&
-                              all_coords[i].coord.hex.r == center.coord.hex.r &&
-                              all_coords[i].coord.hex.s == center.coord.hex.s);
-            if (!is_center) {
+            if (!board_tile_at_cell(board, all_coords[i])) {
                 all_coords[filtered_count++] = all_coords[i];
             }
         }
@@ -280,15 +578,16 @@ void board_randomize(board_t *board, int radius, board_type_e board_type) {
     // Place tiles at random coordinates
     size_t created_tiles = 0;
     for (size_t i = 0; i < coord_count && created_tiles < target_tiles; i++) {
-        grid_cell_t cell = all_coords[i];
-        tile_t *tile = tile_create_random_ptr(cell);
-        if (tile->data.type != TILE_EMPTY) {
-            tile->pool_id = 0; // Will be assigned in board_add_tile
-            board_add_tile(board, tile);
-            created_tiles++;
-        } else {
-            free(tile); // Free empty tiles
+        tile_data_t data = tile_data_create_random();
+        if (data.type == TILE_EMPTY) {
+            continue; // Leave empty cells unoccupied
+        }
+        tile_t *tile = board_create_tile(board, all_coords[i], data);
+        if (!tile) {
+            break;
         }
+        board_add_tile(board, tile);
+        created_tiles++;
     }
 
     free(all_coords);
@@ -334,38 +633,38 @@ void board_fill_fast(board_t *board, int radius, board_type_e board_type) {
     tile_t **tiles = malloc(coord_count * sizeof(tile_t *));
     size_t tile_count = 0;
 
-    size_t created_tiles = (board_type == BOARD_TYPE_MAIN)
-                             ? 1
-                             : 0; // Start with 1 for center tile if main board
+    // Start with the center cluster tiles if this is a main board
+    size_t created_tiles = (size_t)tile_map_size(board->tiles);
 
     // Generate all tile data first (no pool assignment yet)
     for (size_t i = 0; i < coord_count; i++) {
         grid_cell_t cell = all_coords[i];
 
-        // Skip center coordinate if we placed a center tile
-        if (board_type == BOARD_TYPE_MAIN) {
-            grid_cell_t center = grid_geometry_get_origin(board->geometry_type);
-            bool is_center = (cell.coord.hex.q == center.coord.hex.q &&
-                              cell.coord.hex.r == center.coord.hex.r &&
-                              cell.coord.hex.s == center.coord.hex.s);
-            if (is_center) {
-                continue;
-            }
+        // Skip cells already taken by the center cluster
+        if (board_tile_at_cell(board, cell)) {
+            continue;
         }
 
-        tile_t *tile = tile_create_random_ptr(cell);
-        if (tile->data.type != TILE_EMPTY) {
-            tile->pool_id = 0; // Will be assigned by batch assignment
-            tiles[tile_count++] = tile;
-            created_tiles++;
-        } else {
-            free(tile); // Free empty tiles
+        tile_data_t data = tile_data_create_random();
+        if (data.type == TILE_EMPTY) {
+            continue; // Leave empty cells unoccupied
+        }
+        tile_t *tile = board_create_tile(board, cell, data);
+        if (!tile) {
+            break;
         }
+        tiles[tile_count++] = tile; // Pool assigned by batch assignment
+        created_tiles++;
     }
 
     clock_t batch_start = clock();
     // Add all tiles to board at once (no pool logic)
-    board_add_tiles_batch(board, tiles, tile_count);
+    if (!board_add_tiles_batch(board, tiles, tile_count)) {
+        fprintf(stderr, "Failed to add %zu tiles to the board\n", tile_count);
+        free(tiles);
+        free(all_coords);
+        return;
+    }
     printf("Added %zu tiles in %.3fs\n", tile_count,
            (double)(clock() - batch_start) / CLOCKS_PER_SEC);
 
@@ -419,38 +718,38 @@ void board_fill_batch(board_t *board, int radius, board_type_e board_type) {
     tile_t **tiles = malloc(coord_count * sizeof(tile_t *));
     size_t tile_count = 0;
 
-    size_t created_tiles = (board_type == BOARD_TYPE_MAIN)
-                             ? 1
-                             : 0; // Start with 1 for center tile if main board
+    // Start with the center cluster tiles if this is a main board
+    size_t created_tiles = (size_t)tile_map_size(board->tiles);
 
     // Generate all tile data first (no pool assignment yet)
     for (size_t i = 0; i < coord_count; i++) {
         grid_cell_t cell = all_coords[i];
 
-        // Skip center coordinate if we placed a center tile
-        if (board_type == BOARD_TYPE_MAIN) {
-            grid_cell_t center = grid_geometry_get_origin(board->geometry_type);
-            bool is_center = (cell.coord.hex.q == center.coord.hex.q &&
-                              cell.coord.hex.r == center.coord.hex.r &&
-                              cell.coord.hex.s == center.coord.hex.s);
-            if (is_center) {
-                continue;
-            }
+        // Skip cells already taken by the center cluster
+        if (board_tile_at_cell(board, cell)) {
+            continue;
         }
 
-        tile_t *tile = tile_create_random_ptr(cell);
-        if (tile->data.type != TILE_EMPTY) {
-            tile->pool_id = 0; // Will be assigned later
-            tiles[tile_count++] = tile;
-            created_tiles++;
-        } else {
-            free(tile); // Free empty tiles
+        tile_data_t data = tile_data_create_random();
+        if (data.type == TILE_EMPTY) {
+            continue; // Leave empty cells unoccupied
         }
+        tile_t *tile = board_create_tile(board, cell, data);
+        if (!tile) {
+            break;
+        }
+        tiles[tile_count++] = tile; // Pool assigned later
+        created_tiles++;
     }
 
     clock_t batch_start = clock();
     // Add all tiles to board at once (no pool logic)
-    board_add_tiles_batch(board, tiles, tile_count);
+    if (!board_add_tiles_batch(board, tiles, tile_count)) {
+        fprintf(stderr, "Failed to add %zu tiles to the board\n", tile_count);
+        free(tiles);
+        free(all_coords);
+        return;
+    }
     printf("Added %zu tiles in %.3fs\n", tile_count,
            (double)(clock() - batch_start) / CLOCKS_PER_SEC);
 
@@ -470,31 +769,147 @@ void board_fill_batch(board_t *board, int radius, board_type_e board_type) {
            (double)(clock() - start_time) / CLOCKS_PER_SEC);
 }
 
-void board_add_tiles_batch(board_t *board, tile_t **tiles, size_t count) {
-    if (!board || !tiles || count == 0)
-        return;
+// Whether every tile of a batch lies within the board's radius
+static bool board_tiles_in_bounds(const board_t *board, tile_t *const *tiles,
+                                  size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (tiles[i] && !board_cell_in_bounds(board, tiles[i]->cell))
+            return false;
+    }
+    return true;
+}
 
-    // Add all tiles to the board's tile map without pool assignment
+bool board_add_tiles_batch(board_t *board, tile_t **tiles, size_t count) {
+    if (!board || !tiles)
+        return false;
+    if (count == 0)
+        return true;
+
+    // Add all tiles to the board's tile map without pool assignment. A
+    // failed insert leaves the map untouched, so stop before the store and
+    // bitboard see any of the tiles.
+    if (!board_tiles_in_bounds(board, tiles, count) ||
+        !tile_map_add_bulk(board->tiles, tiles, count))
+        return false;
     for (size_t i = 0; i < count; i++) {
         if (tiles[i]) {
-            tile_map_add_unchecked(board->tiles, tiles[i]);
+            tile_store_add(board->store, tiles[i]);
+            bitboard_set(board->occupancy, tiles[i]->cell);
         }
     }
+    board_extent_add_tiles(board, tiles, count);
+    // Once every tile is in place, so each pair is linked from both sides
+    for (size_t i = 0; i < count; i++) {
+        if (tiles[i])
+            board_link_neighbor_masks(board, tiles[i], NULL);
+    }
+    board->store->pool_ids_dirty = true;
+    return true;
+}
+
+bool board_place_tiles(board_t *board, tile_t **tiles, size_t count) {
+    if (!board || !tiles)
+        return false;
+    if (count == 0)
+        return true;
+
+    if (!board_tiles_in_bounds(board, tiles, count) ||
+        !tile_map_add_bulk(board->tiles, tiles, count))
+        return false;
+    for (size_t i = 0; i < count; i++) {
+        if (tiles[i]) {
+            tiles[i]->pool_id = 0;
+            tile_store_add(board->store, tiles[i]);
+            bitboard_set(board->occupancy, tiles[i]->cell);
+        }
+    }
+    board_extent_add_tiles(board, tiles, count);
+    board->store->pool_ids_dirty = true;
+
+    // Link once every tile is in place. The pools around the new tiles gain
+    // neighbor tiles; new tiles have no pool yet, so only pools that were
+    // already on the board are touched here.
+    tile_t *neighbors[TILE_MAX_NEIGHBORS];
+    for (size_t i = 0; i < count; i++) {
+        if (!tiles[i])
+            continue;
+        board_link_neighbor_masks(board, tiles[i], neighbors);
+        board_invalidate_neighbor_pools(board, neighbors);
+    }
+
+    // Group the new tiles by connected type, walking only the same-type
+    // directions of their masks. A group also takes in the singletons it
+    // reaches and collects the pools it touches, then is assigned at once.
+    // One epoch covers every group, so no tile is visited twice.
+    kvec_t(tile_t *) group;
+    kvec_t(uint32_t) pool_ids;
+    kv_init(group);
+    kv_init(pool_ids);
+    grid_cell_t neighbor_cells[TILE_MAX_NEIGHBORS];
+    board_traversal_begin(board);
+    for (size_t i = 0; i < count; i++) {
+        if (!tiles[i] || !board_traversal_mark(board, tiles[i]))
+            continue;
+        kv_size(group) = 0;
+        kv_size(pool_ids) = 0;
+        kv_push(tile_t *, group, tiles[i]);
+        for (size_t head = 0; head < kv_size(group); head++) {
+            tile_t *tile = kv_A(group, head);
+            if (!tile->same_type_mask)
+                continue;
+            hex_kernel_grid_neighbors(board->geometry_type, tile->cell,
+                                      neighbor_cells);
+            for (int d = 0; d < TILE_MAX_NEIGHBORS; d++) {
+                if (!(tile->same_type_mask & (1u << d)))
+                    continue;
+                tile_t *neighbor = tile_map_get(board->tiles, neighbor_cells[d]);
+                uint32_t pool_id =
+                  pool_manager_tile_pool_id(board->pools, neighbor);
+                if (pool_id == 0) {
+                    if (board_traversal_mark(board, neighbor))
+                        kv_push(tile_t *, group, neighbor);
+                    continue;
+                }
+                size_t p = 0;
+                while (p < kv_size(pool_ids) && kv_A(pool_ids, p) != pool_id)
+                    p++;
+                if (p == kv_size(pool_ids))
+                    kv_push(uint32_t, pool_ids, pool_id);
+            }
+        }
+        pool_manager_assign_group(board->pools, group.a, kv_size(group),
+                                  pool_ids.a, kv_size(pool_ids),
+                                  board->geometry_type, board->tiles);
+    }
+    kv_destroy(group);
+    kv_destroy(pool_ids);
+    return true;
 }
 
 void assign_pools_batch(board_t *board) {
     if (!board || !board->tiles)
         return;
+    board->store->pool_ids_dirty = true;
+
+    // Hex boards are labeled in parallel stripes; see board_labeling.h
+    if (board->geometry_type == GRID_TYPE_HEXAGON) {
+        printf("Starting pool assignment for %zu tiles...\n",
+               (size_t)tile_map_size(board->tiles));
+        size_t pools_created = board_label_pools(board, 0);
+        printf("Created %zu pools total\n", pools_created);
+        return;
+    }
 
     // Use flood-fill algorithm to find connected components of same-colored
     // tiles This is much more efficient than checking neighbors for each tile
     // individually
 
-    tile_map_entry_t *entry, *tmp;
+    tile_map_iter_t iter;
+    tile_t *tile;
 
     // First pass: mark all tiles as unassigned
-    HASH_ITER(hh, board->tiles->root, entry, tmp) {
-        entry->tile->pool_id = 0; // 0 means unassigned
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        tile->pool_id = 0; // 0 means unassigned
     }
 
     // next_pool_id removed - pool_manager manages IDs automatically
@@ -503,14 +918,12 @@ void assign_pools_batch(board_t *board) {
     printf("Starting pool assignment for %zu tiles...\n",
            (size_t)tile_map_size(board->tiles));
     size_t pools_created = 0;
-    HASH_ITER(hh, board->tiles->root, entry, tmp) {
-        tile_t *tile = entry->tile;
-
+    TILE_MAP_ITER(board->tiles, tile, iter) {
         if (tile->pool_id == 0) { // Unassigned
             // First check if this tile has same-color neighbors
             grid_cell_t neighbor_cells[6];
-            grid_geometry_get_all_neighbors(board->geometry_type, tile->cell,
-                                            neighbor_cells);
+            hex_kernel_grid_neighbors(board->geometry_type, tile->cell,
+                                      neighbor_cells);
             int neighbor_count = 6; // Hex geometry always has 6 neighbors
             bool has_same_color_neighbors = false;
 
@@ -539,66 +952,37 @@ void assign_pools_batch(board_t *board) {
         }
     }
     printf("Created %zu pools total\n", pools_created);
+    pool_manager_rebuild_adjacency(board->pools, board->geometry_type,
+                                   board->tiles);
+    pool_manager_rebuild_leaderboard(board->pools);
 }
 
-void flood_fill_assign_pool(board_t *board, tile_t *start_tile, pool_t *pool) {
-    if (!board || !start_tile || !pool || start_tile->pool_id != 0)
-        return;
-
-    // Use iterative flood-fill with stack to prevent stack overflow on large
-    // boards
-    tile_t **stack = malloc(
-      100000 * sizeof(tile_t *)); // Start with larger size for big boards
-    size_t stack_size = 0;
-    size_t stack_capacity = 100000;
-
-    // Add start tile to stack
-    stack[stack_size++] = start_tile;
-
-    while (stack_size > 0) {
-        // Pop tile from stack
-        tile_t *current_tile = stack[--stack_size];
+typedef struct {
+    board_t *board;
+    pool_t *pool;
+} flood_fill_context_t;
 
-        // Skip if already processed
-        if (current_tile->pool_id != 0)
-            continue;
+static bool flood_fill_accepts(const tile_t *from, const tile_t *to,
+                               void *user_data) {
+    (void)user_data;
+    return to->pool_id == 0 && to->data.type == from->data.type;
+}
 
-        // Assign to pool
-        current_tile->pool_id = pool->id;
-        pool_add_tile(pool, current_tile, board->geometry_type, board->tiles);
-
-        // Check all 6 neighbors
-        for (int dir = 0; dir < 6; dir++) {
-            grid_cell_t neighbor_cell;
-            grid_geometry_get_neighbor(board->geometry_type, current_tile->cell,
-                                       dir, &neighbor_cell);
-            tile_t *neighbor = board_tile_at_cell(board, neighbor_cell);
-
-            if (neighbor && neighbor->pool_id == 0 &&             // Unassigned
-                neighbor->data.type == current_tile->data.type) { // Same type
-
-                // Expand stack if needed (use larger increments)
-                if (stack_size >= stack_capacity) {
-                    size_t new_capacity =
-                      stack_capacity + 50000; // Add 50k at a time
-                    tile_t **new_stack =
-                      realloc(stack, new_capacity * sizeof(tile_t *));
-                    if (!new_stack) {
-                        printf("ERROR: Failed to expand flood-fill stack\n");
-                        free(stack);
-                        return;
-                    }
-                    stack = new_stack;
-                    stack_capacity = new_capacity;
-                }
+static void flood_fill_visit(tile_t *tile, void *user_data) {
+    flood_fill_context_t *context = user_data;
+    tile->pool_id = context->pool->id;
+    pool_add_tile(context->pool, tile, context->board->geometry_type,
+                  context->board->tiles);
+}
 
-                // Add neighbor to stack
-                stack[stack_size++] = neighbor;
-            }
-        }
-    }
+void flood_fill_assign_pool(board_t *board, tile_t *start_tile, pool_t *pool) {
+    if (!board || !start_tile || !pool || start_tile->pool_id != 0)
+        return;
 
-    free(stack);
+    // Walks the unassigned same-type component on the board's scratch stack
+    flood_fill_context_t context = {.board = board, .pool = pool};
+    board_traverse_dfs(board, start_tile, flood_fill_accepts, flood_fill_visit,
+                       &context);
 }
 
 // Function to check if a board merge is valid (no tile overlaps)
@@ -612,19 +996,30 @@ bool is_merge_valid(board_t *target_board, board_t *source_board,
     grid_cell_t offset = grid_geometry_calculate_offset(
       source_board->geometry_type, source_center, target_center);
 
-    // Check each tile in the source board directly
+    // Bounds and overlap in one row-wise AND/popcount pass, as long as the
+    // piece's bitboard holds every one of its tiles
+    if (source_board->occupancy && target_board->occupancy &&
+        source_board->occupancy->count == tile_map_size(source_board->tiles)) {
+        size_t out_of_bounds = 0;
+        size_t overlap =
+          bitboard_count_overlap(target_board->occupancy,
+                                 source_board->occupancy, offset, &out_of_bounds);
+        return overlap == 0 && out_of_bounds == 0;
+    }
 
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, source_board->tiles->root, entry, tmp) {
-        grid_cell_t source_cell = entry->tile->cell;
+    // Otherwise check each tile in the source board directly
+    tile_map_iter_t iter;
+    tile_t *source_tile;
+    TILE_MAP_ITER(source_board->tiles, source_tile, iter) {
+        grid_cell_t source_cell = source_tile->cell;
         grid_cell_t target_position = grid_geometry_apply_offset(
           source_board->geometry_type, source_cell, offset);
 
         // Check if this position is valid in the target board
         grid_cell_t origin =
           grid_geometry_get_origin(target_board->geometry_type);
-        int distance = grid_geometry_distance(target_board->geometry_type,
-                                              target_position, origin);
+        int distance = hex_kernel_grid_distance(target_board->geometry_type,
+                                                target_position, origin);
         if (distance > target_board->radius) {
             return false; // Target position out of bounds
         }
@@ -650,11 +1045,12 @@ bool merge_boards(board_t *target_board, board_t *source_board,
     grid_cell_t offset = grid_geometry_calculate_offset(
       source_board->geometry_type, source_center, target_center);
 
-    // Merge each tile from source to target
-    int tiles_added = 0;
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, source_board->tiles->root, entry, tmp) {
-        tile_t *source_tile = entry->tile;
+    // Create every tile first, then place them in one transaction
+    kvec_t(tile_t *) new_tiles;
+    kv_init(new_tiles);
+    tile_map_iter_t iter;
+    tile_t *source_tile;
+    TILE_MAP_ITER(source_board->tiles, source_tile, iter) {
 
         // Apply offset to get the target position
         grid_cell_t target_position = grid_geometry_apply_offset(
@@ -663,29 +1059,27 @@ bool merge_boards(board_t *target_board, board_t *source_board,
         // Check if this position is valid in the target board
         grid_cell_t origin =
           grid_geometry_get_origin(target_board->geometry_type);
-        int distance = grid_geometry_distance(target_board->geometry_type,
-                                              target_position, origin);
+        int distance = hex_kernel_grid_distance(target_board->geometry_type,
+                                                target_position, origin);
         if (distance > target_board->radius) {
             continue; // Skip tiles that would fall outside the target board
         }
 
         // Create a new tile at the target position with the same data
-        tile_t *new_tile = malloc(sizeof(tile_t));
+        tile_t *new_tile =
+          board_create_tile(target_board, target_position, source_tile->data);
         if (!new_tile) {
             fprintf(stderr, "Failed to allocate memory for merged tile\n");
+            kv_destroy(new_tiles);
             return false;
         }
-
-        new_tile->cell = target_position;
-        new_tile->data = source_tile->data; // Copy tile data
-        new_tile->pool_id = 0; // Will be assigned in board_add_tile
-
-        // Add the tile to the target board
-        board_add_tile(target_board, new_tile);
-        tiles_added++;
+        kv_push(tile_t *, new_tiles, new_tile);
     }
 
-    return true;
+    bool placed =
+      board_place_tiles(target_board, new_tiles.a, kv_size(new_tiles));
+    kv_destroy(new_tiles);
+    return placed;
 }
 
 // Board rotation function - rotates all tiles around a center point
@@ -701,29 +1095,47 @@ bool board_rotate(board_t *board, grid_cell_t center, int rotation_steps) {
         return true; // No rotation needed
     }
 
-    // Create a temporary clone to validate rotation before modifying original
-    tile_map_t *temp_map = tile_map_clone(board->tiles);
-    if (!temp_map) {
-        return false;
+    tile_map_transform_t transform =
+      tile_map_transform_rotation(center, rotation_steps);
+
+    // Validate all rotated positions are within grid bounds before moving
+    grid_cell_t origin = grid_geometry_get_origin(board->geometry_type);
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        grid_cell_t rotated = tile_map_transform_cell(&transform, tile->cell);
+        if (hex_kernel_grid_distance(board->geometry_type, rotated, origin) >
+            board->radius) {
+            return false;
+        }
     }
 
-    // Perform rotation on the clone
-    if (!tile_map_rotate(temp_map, center, rotation_steps)) {
-        tile_map_free(temp_map);
+    // Rotation is a bijection, so the board map is rebuilt in one pass
+    if (!tile_map_transform(board->tiles, &transform)) {
         return false;
     }
 
-    // Validate all rotated positions are within grid bounds
-    if (!board_validate_tile_map_bounds(board, temp_map)) {
-        tile_map_free(temp_map);
-        return false;
+    // Rebuild occupancy from the moved tiles
+    bitboard_clear(board->occupancy);
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        bitboard_set(board->occupancy, tile->cell);
+    }
+    board_extent_rebuild(board);
+
+    // Each tile keeps its neighbors, now in rotated directions; neighbor
+    // counts do not change, so the pool histograms stay valid
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        board_compute_neighbor_masks(board, tile);
     }
 
-    // Validation passed - apply rotation to original tile map
-    bool success = tile_map_rotate(board->tiles, center, rotation_steps);
-    tile_map_free(temp_map);
+    // Pool maps share the moved tiles; re-key them to the new cells
+    pool_manager_entry_t *pool_entry;
+    for (pool_entry = board->pools->root; pool_entry != NULL;
+         pool_entry = pool_entry->hh.next) {
+        pool_apply_transform(pool_entry->pool, &transform);
+    }
 
-    return success;
+    return true;
 }
 
 // Get neighbor cell in a specific hex direction
@@ -737,11 +1149,12 @@ bool board_validate_tile_map_bounds(const board_t *board,
         return true; // Empty map is valid
 
     // Validate each tile is within board's spatial bounds
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, tile_map->root, entry, tmp) {
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(tile_map, tile, iter) {
         grid_cell_t origin = grid_geometry_get_origin(board->geometry_type);
-        int distance = grid_geometry_distance(board->geometry_type,
-                                              entry->tile->cell, origin);
+        int distance =
+          hex_kernel_grid_distance(board->geometry_type, tile->cell, origin);
         if (distance > board->radius) {
             return false;
         }
@@ -753,29 +1166,89 @@ bool board_validate_tile_map_bounds(const board_t *board,
 bool board_calculate_bounds(const board_t *board, float *out_min_x,
                             float *out_min_y, float *out_max_x,
                             float *out_max_y) {
-    if (!board || !board->tiles || tile_map_size(board->tiles) == 0) {
+    if (!board || !board->extent.has_tiles) {
         return false;
     }
 
-    // Get all tile cells from the board
-    size_t tile_count = tile_map_size(board->tiles);
-    grid_cell_t *cells = malloc(tile_count * sizeof(grid_cell_t));
-    if (!cells) {
+    // The extreme tiles bound every other tile's polygon
+    if (board_extent_current(board)) {
+        grid_cell_t cells[4];
+        for (int k = 0; k < 4; k++) {
+            cells[k] = board->extent.cells[k];
+        }
+        return grid_geometry_calculate_bounds(
+          board->geometry_type, &board->layout, cells, 4, out_min_x,
+          out_min_y, out_max_x, out_max_y);
+    }
+
+    // The orientation changed since the extent was built; scan every tile
+    // until the next tile change rebuilds it
+    grid_cell_t block[BOARD_EXTENT_BLOCK];
+    size_t n = 0;
+    bool has_bounds = false;
+    float min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    tile_map_iter_t iter;
+    tile_map_iter_init(&iter, board->tiles);
+    for (;;) {
+        tile_t *tile = tile_map_iter_next(&iter);
+        if (tile) {
+            block[n++] = tile->cell;
+            if (n < BOARD_EXTENT_BLOCK)
+                continue;
+        }
+
+        float bx0, by0, bx1, by1;
+        if (n > 0 && grid_geometry_calculate_bounds(
+                       board->geometry_type, &board->layout, block, n, &bx0,
+                       &by0, &bx1, &by1)) {
+            min_x = has_bounds && min_x < bx0 ? min_x : bx0;
+            min_y = has_bounds && min_y < by0 ? min_y : by0;
+            max_x = has_bounds && max_x > bx1 ? max_x : bx1;
+            max_y = has_bounds && max_y > by1 ? max_y : by1;
+            has_bounds = true;
+        }
+        n = 0;
+        if (!tile)
+            break;
+    }
+    if (!has_bounds || !out_min_x || !out_min_y || !out_max_x || !out_max_y) {
         return false;
     }
 
-    // Collect all tile cells
-    size_t index = 0;
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, board->tiles->root, entry, tmp) {
-        cells[index++] = entry->tile->cell;
+    *out_min_x = min_x;
+    *out_min_y = min_y;
+    *out_max_x = max_x;
+    *out_max_y = max_y;
+    return true;
+}
+
+bool board_region_bounds(const board_t *board, float *out_min_x,
+                         float *out_min_y, float *out_max_x,
+                         float *out_max_y) {
+    if (!board) {
+        return false;
     }
+    return grid_geometry_region_bounds(
+      board->geometry_type, &board->layout,
+      grid_geometry_get_origin(board->geometry_type), board->radius,
+      out_min_x, out_min_y, out_max_x, out_max_y);
+}
+
+void board_sum_production(const board_t *board, tile_store_production_t *out) {
+    tile_store_sum_production(board ? board->store : NULL, out);
+}
 
-    // Use the optimized grid_geometry function
-    bool result = grid_geometry_calculate_bounds(
-      board->geometry_type, &board->layout, cells, tile_count, out_min_x,
-      out_min_y, out_max_x, out_max_y);
+float board_pool_production(board_t *board, uint32_t pool_id) {
+    if (!board || pool_id == 0)
+        return 0.0f;
 
-    free(cells);
-    return result;
+    // Tiles of merged pools may still carry an absorbed id; resolve them
+    // before the column is refreshed
+    if (board->store->pool_ids_dirty) {
+        for (size_t i = 0; i < board->store->count; i++) {
+            pool_manager_tile_pool_id(board->pools, board->store->tiles[i]);
+        }
+    }
+    return tile_store_pool_production(
+      board->store, pool_manager_resolve_id(board->pools, pool_id));
 }
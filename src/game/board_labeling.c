@@ -0,0 +1,305 @@
+#include "game/board_labeling.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#define BOARD_LABELING_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define BOARD_LABEL_EMPTY UINT32_MAX
+#define BOARD_LABELING_MIN_ROWS 8 // Fewer rows per stripe is not worth a thread
+
+// Slot arrays shared by every worker. Slot (q, r) is
+// (r + radius) * stride + (q + radius); a worker only writes the slots of its
+// own rows.
+typedef struct {
+    const board_t *board;
+    int radius;
+    int stride;
+    uint32_t *parent; // Union-find parent per slot, or BOARD_LABEL_EMPTY
+    int8_t *types;    // Tile type per occupied slot
+    uint32_t *roots;  // Component root per slot, or BOARD_LABEL_EMPTY
+    pool_t **pools;   // Pool created for each component root
+    int worker_count;
+} board_labels_t;
+
+typedef struct {
+    board_labels_t *labels;
+    int index;     // Worker index; also picks the pools the worker fills
+    int row_begin; // First r of the stripe
+    int row_end;   // One past the last r
+} board_labeling_stripe_t;
+
+static size_t board_labeling_slot(const board_labels_t *labels,
+                                  grid_cell_t cell) {
+    return (size_t)(cell.coord.hex.r + labels->radius) * labels->stride +
+           (size_t)(cell.coord.hex.q + labels->radius);
+}
+
+static uint32_t board_labeling_find(uint32_t *parent, uint32_t slot) {
+    while (parent[slot] != slot) {
+        parent[slot] = parent[parent[slot]];
+        slot = parent[slot];
+    }
+    return slot;
+}
+
+static void board_labeling_union(uint32_t *parent, uint32_t a, uint32_t b) {
+    a = board_labeling_find(parent, a);
+    b = board_labeling_find(parent, b);
+    if (a == b)
+        return;
+    // The lower slot becomes the root, so roots do not depend on union order
+    if (a < b)
+        parent[b] = a;
+    else
+        parent[a] = b;
+}
+
+// Joins 'slot' with 'other' if both hold tiles of the same type
+static void board_labeling_link(board_labels_t *labels, uint32_t slot,
+                                uint32_t other) {
+    if (labels->parent[other] != BOARD_LABEL_EMPTY &&
+        labels->types[other] == labels->types[slot])
+        board_labeling_union(labels->parent, slot, other);
+}
+
+// Links a slot with its neighbors in the row above, (q, r - 1) and
+// (q + 1, r - 1); the other neighbors come later in scan order
+static void board_labeling_link_above(board_labels_t *labels, int q,
+                                      uint32_t slot) {
+    uint32_t above = slot - (uint32_t)labels->stride;
+    board_labeling_link(labels, slot, above);
+    if (q < labels->radius)
+        board_labeling_link(labels, slot, above + 1);
+}
+
+// Phase 1: fill the stripe's slots and union neighbors inside the stripe
+static void *board_labeling_label_stripe(void *arg) {
+    board_labeling_stripe_t *stripe = arg;
+    board_labels_t *labels = stripe->labels;
+    int radius = labels->radius;
+
+    for (int r = stripe->row_begin; r < stripe->row_end; r++) {
+        int q_min = r < 0 ? -radius - r : -radius;
+        int q_max = r > 0 ? radius - r : radius;
+        uint32_t row = (uint32_t)(r + radius) * (uint32_t)labels->stride;
+        for (int q = -radius; q <= radius; q++) {
+            uint32_t slot = row + (uint32_t)(q + radius);
+            tile_t *tile = NULL;
+            if (q >= q_min && q <= q_max) {
+                grid_cell_t cell = {.type = GRID_TYPE_HEXAGON,
+                                    .coord.hex = {q, r, -q - r}};
+                tile = tile_map_get(labels->board->tiles, cell);
+            }
+            if (!tile) {
+                labels->parent[slot] = BOARD_LABEL_EMPTY;
+                continue;
+            }
+
+            labels->parent[slot] = slot;
+            labels->types[slot] = (int8_t)tile->data.type;
+            if (q > -radius)
+                board_labeling_link(labels, slot, slot - 1);
+            if (r > stripe->row_begin)
+                board_labeling_link_above(labels, q, slot);
+        }
+    }
+    return NULL;
+}
+
+// Phase 3: resolve the stripe's slots to their roots without writing to the
+// shared forest
+static void *board_labeling_resolve_stripe(void *arg) {
+    board_labeling_stripe_t *stripe = arg;
+    board_labels_t *labels = stripe->labels;
+    size_t begin = (size_t)(stripe->row_begin + labels->radius) * labels->stride;
+    size_t end = (size_t)(stripe->row_end + labels->radius) * labels->stride;
+
+    for (size_t slot = begin; slot < end; slot++) {
+        uint32_t root = labels->parent[slot];
+        if (root != BOARD_LABEL_EMPTY) {
+            while (labels->parent[root] != root)
+                root = labels->parent[root];
+        }
+        labels->roots[slot] = root;
+    }
+    return NULL;
+}
+
+// Phase 5: add the tiles of this worker's pools in tile map order, so every
+// pool is built exactly as the serial flood fill would build it. Pools share
+// no state, so workers never touch the same pool.
+static void *board_labeling_fill_pools(void *arg) {
+    board_labeling_stripe_t *stripe = arg;
+    board_labels_t *labels = stripe->labels;
+    const board_t *board = labels->board;
+
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        if (tile->pool_id == 0)
+            continue;
+        pool_t *pool =
+          labels->pools[labels->roots[board_labeling_slot(labels, tile->cell)]];
+        if (pool->id % labels->worker_count == stripe->index)
+            pool_add_tile(pool, tile, board->geometry_type, board->tiles);
+    }
+    return NULL;
+}
+
+// Runs 'work' on every stripe, one thread each, with the first stripe on the
+// calling thread
+static void board_labeling_run(board_labeling_stripe_t *stripes,
+                               int stripe_count, void *(*work)(void *)) {
+#ifdef BOARD_LABELING_PTHREADS
+    pthread_t threads[stripe_count];
+    bool started[stripe_count];
+    for (int i = 1; i < stripe_count; i++) {
+        started[i] =
+          pthread_create(&threads[i], NULL, work, &stripes[i]) == 0;
+        if (!started[i])
+            work(&stripes[i]);
+    }
+    work(&stripes[0]);
+    for (int i = 1; i < stripe_count; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+    }
+#else
+    for (int i = 0; i < stripe_count; i++) {
+        work(&stripes[i]);
+    }
+#endif
+}
+
+static int board_labeling_default_threads(void) {
+#ifdef BOARD_LABELING_PTHREADS
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+#else
+    return 1;
+#endif
+}
+
+// Splits the rows into stripes holding about the same number of cells
+static int board_labeling_split(board_labels_t *labels, int thread_count,
+                                board_labeling_stripe_t *stripes) {
+    int radius = labels->radius;
+    size_t total = 3 * (size_t)radius * (radius + 1) + 1;
+    size_t per_stripe = (total + thread_count - 1) / thread_count;
+
+    int stripe_count = 0;
+    size_t filled = 0;
+    int row_begin = -radius;
+    for (int r = -radius; r <= radius; r++) {
+        filled += (size_t)(labels->stride - (r < 0 ? -r : r));
+        if (filled >= per_stripe || r == radius) {
+            stripes[stripe_count].labels = labels;
+            stripes[stripe_count].index = stripe_count;
+            stripes[stripe_count].row_begin = row_begin;
+            stripes[stripe_count].row_end = r + 1;
+            stripe_count++;
+            row_begin = r + 1;
+            filled = 0;
+        }
+    }
+    return stripe_count;
+}
+
+size_t board_label_pools(board_t *board, int thread_count) {
+    if (!board || !board->tiles || board->radius < 0)
+        return 0;
+
+    board_labels_t labels = {.board = board,
+                             .radius = board->radius,
+                             .stride = 2 * board->radius + 1};
+    size_t slot_count = (size_t)labels.stride * labels.stride;
+    labels.parent = malloc(slot_count * sizeof(uint32_t));
+    labels.types = malloc(slot_count * sizeof(int8_t));
+    labels.roots = malloc(slot_count * sizeof(uint32_t));
+    labels.pools = calloc(slot_count, sizeof(pool_t *));
+    if (!labels.parent || !labels.types || !labels.roots || !labels.pools) {
+        fprintf(stderr, "Out of memory!\n");
+        free(labels.parent);
+        free(labels.types);
+        free(labels.roots);
+        free(labels.pools);
+        return 0;
+    }
+
+    if (thread_count <= 0)
+        thread_count = board_labeling_default_threads();
+    int max_stripes = labels.stride / BOARD_LABELING_MIN_ROWS;
+    if (thread_count > max_stripes)
+        thread_count = max_stripes > 0 ? max_stripes : 1;
+    board_labeling_stripe_t stripes[thread_count];
+    int stripe_count = board_labeling_split(&labels, thread_count, stripes);
+    labels.worker_count = stripe_count;
+
+    // Phase 1: label each stripe on its own
+    board_labeling_run(stripes, stripe_count, board_labeling_label_stripe);
+
+    // Phase 2: join components across the stripe borders
+    for (int i = 1; i < stripe_count; i++) {
+        int r = stripes[i].row_begin;
+        uint32_t row = (uint32_t)(r + labels.radius) * (uint32_t)labels.stride;
+        for (int q = -labels.radius; q <= labels.radius; q++) {
+            uint32_t slot = row + (uint32_t)(q + labels.radius);
+            if (labels.parent[slot] != BOARD_LABEL_EMPTY)
+                board_labeling_link_above(&labels, q, slot);
+        }
+    }
+
+    // Phase 3: resolve every slot to its root
+    board_labeling_run(stripes, stripe_count, board_labeling_resolve_stripe);
+
+    // Component sizes, counted on the roots; the forest is no longer needed
+    uint32_t *sizes = labels.parent;
+    memset(sizes, 0, slot_count * sizeof(uint32_t));
+    for (size_t slot = 0; slot < slot_count; slot++) {
+        if (labels.roots[slot] != BOARD_LABEL_EMPTY)
+            sizes[labels.roots[slot]]++;
+    }
+
+    // Phase 4: create pools in tile map order, each one when its first tile
+    // is reached, so pool ids match the serial flood fill
+    size_t pools_created = 0;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(board->tiles, tile, iter) {
+        tile->pool_id = 0;
+        if (!bitboard_in_bounds(board->occupancy, tile->cell))
+            continue;
+        uint32_t root = labels.roots[board_labeling_slot(&labels, tile->cell)];
+        if (root == BOARD_LABEL_EMPTY || sizes[root] < 2)
+            continue;
+
+        pool_t *pool = labels.pools[root];
+        if (!pool) {
+            pool = pool_manager_create_pool(board->pools);
+            if (!pool)
+                continue;
+            pool->accepted_tile_type = tile->data.type;
+            labels.pools[root] = pool;
+            pools_created++;
+        }
+        tile->pool_id = pool->id;
+    }
+
+    // Phase 5: fill the pools, split between the workers by pool id
+    board_labeling_run(stripes, stripe_count, board_labeling_fill_pools);
+    pool_manager_rebuild_adjacency(board->pools, board->geometry_type,
+                                   board->tiles);
+    pool_manager_rebuild_leaderboard(board->pools);
+
+    free(labels.parent);
+    free(labels.types);
+    free(labels.roots);
+    free(labels.pools);
+    return pools_created;
+}
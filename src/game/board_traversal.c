@@ -0,0 +1,117 @@
+#include "game/board_traversal.h"
+#include "grid/hex_kernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+board_traversal_t *board_traversal_create(void) {
+    board_traversal_t *traversal = calloc(1, sizeof(board_traversal_t));
+    if (!traversal) {
+        fprintf(stderr, "Out of memory!\n");
+        return NULL;
+    }
+    kv_init(traversal->stack);
+    return traversal;
+}
+
+void board_traversal_free(board_traversal_t *traversal) {
+    if (!traversal)
+        return;
+    kv_destroy(traversal->stack);
+    free(traversal);
+}
+
+uint32_t board_traversal_begin(const board_t *board) {
+    board_traversal_t *traversal = board->traversal;
+    kv_size(traversal->stack) = 0;
+    if (++traversal->epoch == 0) {
+        // The counter wrapped, so stale stamps could match new epochs
+        tile_map_iter_t iter;
+        tile_t *tile;
+        TILE_MAP_ITER(board->tiles, tile, iter) {
+            tile->visit_epoch = 0;
+        }
+        traversal->epoch = 1;
+    }
+    return traversal->epoch;
+}
+
+bool board_traversal_mark(const board_t *board, tile_t *tile) {
+    if (tile->visit_epoch == board->traversal->epoch)
+        return false;
+    tile->visit_epoch = board->traversal->epoch;
+    return true;
+}
+
+bool board_traversal_is_marked(const board_t *board, const tile_t *tile) {
+    return tile->visit_epoch == board->traversal->epoch;
+}
+
+// Shared loop of every traversal. Tiles are marked when pushed, so each one
+// enters the stack at most once. BFS reads the stack as a queue from 'head';
+// DFS pops from the top. A negative 'max_distance' means no bound.
+static size_t board_traversal_run(const board_t *board, tile_t *start,
+                                  bool depth_first, int max_distance,
+                                  board_traversal_filter_t filter,
+                                  board_traversal_visit_t visit,
+                                  void *user_data) {
+    if (!board || !board->traversal || !start)
+        return 0;
+
+    board_traversal_t *traversal = board->traversal;
+    board_traversal_begin(board);
+    start->visit_epoch = traversal->epoch;
+    kv_push(tile_t *, traversal->stack, start);
+
+    int neighbor_count = grid_geometry_get_neighbor_count(board->geometry_type);
+    grid_cell_t neighbors[neighbor_count];
+    size_t head = 0;
+    size_t visited = 0;
+
+    while (head < kv_size(traversal->stack)) {
+        tile_t *tile = depth_first ? kv_pop(traversal->stack)
+                                   : kv_A(traversal->stack, head++);
+        visited++;
+        if (visit)
+            visit(tile, user_data);
+
+        hex_kernel_grid_neighbors(board->geometry_type, tile->cell, neighbors);
+        for (int i = 0; i < neighbor_count; i++) {
+            tile_t *neighbor = tile_map_get(board->tiles, neighbors[i]);
+            if (!neighbor || neighbor->visit_epoch == traversal->epoch)
+                continue;
+            if (max_distance >= 0 &&
+                hex_kernel_grid_distance(board->geometry_type, start->cell,
+                                         neighbor->cell) > max_distance)
+                continue;
+            if (filter && !filter(tile, neighbor, user_data))
+                continue;
+
+            neighbor->visit_epoch = traversal->epoch;
+            kv_push(tile_t *, traversal->stack, neighbor);
+        }
+    }
+    return visited;
+}
+
+size_t board_traverse_bfs(const board_t *board, tile_t *start,
+                          board_traversal_filter_t filter,
+                          board_traversal_visit_t visit, void *user_data) {
+    return board_traversal_run(board, start, false, -1, filter, visit,
+                               user_data);
+}
+
+size_t board_traverse_dfs(const board_t *board, tile_t *start,
+                          board_traversal_filter_t filter,
+                          board_traversal_visit_t visit, void *user_data) {
+    return board_traversal_run(board, start, true, -1, filter, visit,
+                               user_data);
+}
+
+size_t board_traverse_within(const board_t *board, tile_t *start,
+                             int max_distance, board_traversal_filter_t filter,
+                             board_traversal_visit_t visit, void *user_data) {
+    if (max_distance < 0)
+        return 0;
+    return board_traversal_run(board, start, false, max_distance, filter,
+                               visit, user_data);
+}
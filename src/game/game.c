@@ -99,29 +99,6 @@ void game_clear_preview(game_t *game) {
     game->preview.is_active = false;
 }
 
-bool game_get_preview_conflicts(const game_t *game, grid_cell_t **out_conflicts,
-                                size_t *out_count) {
-    if (!game || !game->preview.is_active || !game->preview.source_board) {
-        if (out_conflicts)
-            *out_conflicts = NULL;
-        if (out_count)
-            *out_count = 0;
-        return true;
-    }
-
-    // Calculate offset from source center to target position
-    grid_cell_t source_center =
-      grid_geometry_get_origin(game->preview.source_board->geometry_type);
-    grid_cell_t offset = grid_geometry_calculate_offset(
-      game->preview.source_board->geometry_type, source_center,
-      game->preview.target_position);
-
-    // Use tile_map functions to find conflicts
-    return tile_map_find_merge_conflicts(game->preview.source_board->tiles,
-                                         game->board->tiles, offset,
-                                         out_conflicts, out_count);
-}
-
 /* Game-level business logic implementations */
 
 bool game_try_place_tile(game_t *game, grid_cell_t target_position) {
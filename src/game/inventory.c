@@ -36,13 +36,13 @@ void inventory_fill_single_tiles(inventory_t *inv) {
         // Generate default tile data
         tile_data_t tile_data = tile_data_create_default(t, 1);
 
-        // Create a tile pointer
-        tile_t *new_tile =
-          tile_create_ptr(grid_geometry_get_origin(inv->grid_type), tile_data);
-
         // Create a board pointer
         board_t *board = board_create(inv->grid_type, 1, BOARD_TYPE_INVENTORY);
 
+        // Create a tile pointer owned by the board
+        tile_t *new_tile = board_create_tile(
+          board, grid_geometry_get_origin(inv->grid_type), tile_data);
+
         // Add tile pointer to board
         board_add_tile(board, new_tile);
 
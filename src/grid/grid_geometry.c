@@ -104,6 +104,96 @@ void grid_geometry_get_corners(grid_type_e type, const layout_t *layout,
     vtable->get_corners(layout, cell, corners);
 }
 
+void grid_geometry_cells_to_pixels(grid_type_e type, const layout_t *layout,
+                                   const grid_cell_t *cells, size_t count,
+                                   float *out_xy) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    if (!vtable || !layout || !cells || !out_xy) {
+        return;
+    }
+    if (vtable->cells_to_pixels) {
+        vtable->cells_to_pixels(layout, cells, count, out_xy);
+        return;
+    }
+    if (!vtable->cell_to_pixel) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        point_t p = vtable->cell_to_pixel(layout, cells[i]);
+        out_xy[2 * i] = (float)p.x;
+        out_xy[2 * i + 1] = (float)p.y;
+    }
+}
+
+void grid_geometry_get_corners_batch(grid_type_e type, const layout_t *layout,
+                                     const grid_cell_t *cells, size_t count,
+                                     float *out_xy) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    if (!vtable || !vtable->get_corners || !layout || !cells || !out_xy) {
+        return;
+    }
+    int corner_count = vtable->corner_count;
+
+    if (!vtable->get_corner_offsets) {
+        // Cells differ in shape, so ask for each cell's corners
+        point_t corners[GRID_MAX_CORNERS];
+        for (size_t i = 0; i < count; i++) {
+            vtable->get_corners(layout, cells[i], corners);
+            for (int j = 0; j < corner_count; j++) {
+                *out_xy++ = (float)corners[j].x;
+                *out_xy++ = (float)corners[j].y;
+            }
+        }
+        return;
+    }
+
+    // Every corner is a cell center plus one offset of the template
+    point_t computed[GRID_MAX_CORNERS];
+    const point_t *offsets = layout->corner_offsets;
+    if (!grid_geometry_layout_corners_current(layout)) {
+        vtable->get_corner_offsets(layout, computed);
+        offsets = computed;
+    }
+    float offset_xy[2 * GRID_MAX_CORNERS];
+    for (int j = 0; j < corner_count; j++) {
+        offset_xy[2 * j] = (float)offsets[j].x;
+        offset_xy[2 * j + 1] = (float)offsets[j].y;
+    }
+
+    enum { BLOCK = 64 };
+    float centers[2 * BLOCK];
+    for (size_t begin = 0; begin < count; begin += BLOCK) {
+        size_t n = count - begin < BLOCK ? count - begin : BLOCK;
+        grid_geometry_cells_to_pixels(type, layout, cells + begin, n, centers);
+        for (size_t i = 0; i < n; i++) {
+            float x = centers[2 * i];
+            float y = centers[2 * i + 1];
+            for (int j = 0; j < corner_count; j++) {
+                out_xy[2 * j] = x + offset_xy[2 * j];
+                out_xy[2 * j + 1] = y + offset_xy[2 * j + 1];
+            }
+            out_xy += 2 * corner_count;
+        }
+    }
+}
+
+void grid_geometry_update_layout(grid_type_e type, layout_t *layout) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    if (!vtable || !vtable->get_corner_offsets || !layout) {
+        return;
+    }
+    vtable->get_corner_offsets(layout, layout->corner_offsets);
+    layout->corner_extent = (point_t){layout->size.x * layout->scale,
+                                      layout->size.y * layout->scale};
+    layout->corner_angle = layout->orientation.start_angle;
+}
+
+bool grid_geometry_layout_corners_current(const layout_t *layout) {
+    return layout->corner_extent.x == layout->size.x * layout->scale &&
+           layout->corner_extent.y == layout->size.y * layout->scale &&
+           layout->corner_angle == layout->orientation.start_angle;
+}
+
 bool grid_geometry_rotate_cell(grid_type_e type, grid_cell_t cell,
                                int rotations, grid_cell_t *out_cell) {
     const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
@@ -166,6 +256,76 @@ void grid_geometry_get_line(grid_type_e type, grid_cell_t start,
     vtable->get_line(start, end, out_cells, out_count);
 }
 
+void grid_geometry_get_spiral(grid_type_e type, grid_cell_t center,
+                              int max_radius, grid_cell_t **out_cells,
+                              size_t *out_count) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    if (!vtable || !vtable->get_spiral) {
+        if (out_cells)
+            *out_cells = NULL;
+        if (out_count)
+            *out_count = 0;
+        return;
+    }
+    vtable->get_spiral(center, max_radius, out_cells, out_count);
+}
+
+// --- Iterators ---
+
+// Fills in the shape shared by every iterator and lets the grid position it
+static void grid_iter_start(grid_iter_t *iter, grid_type_e type,
+                            grid_iter_kind_e kind, grid_cell_t center,
+                            grid_cell_t end, int min_radius, int max_radius) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    *iter = (grid_iter_t){.vtable = vtable,
+                          .kind = kind,
+                          .center = center,
+                          .end = end,
+                          .min_radius = min_radius,
+                          .max_radius = max_radius};
+    if (!vtable || !vtable->iter_begin || !vtable->iter_next ||
+        center.type != type || min_radius < 0 || max_radius < min_radius) {
+        iter->vtable = NULL;
+        return;
+    }
+    vtable->iter_begin(iter);
+}
+
+void grid_iter_range(grid_iter_t *iter, grid_type_e type, grid_cell_t center,
+                     int range) {
+    grid_iter_start(iter, type, GRID_ITER_RANGE, center, center, 0, range);
+}
+
+void grid_iter_ring(grid_iter_t *iter, grid_type_e type, grid_cell_t center,
+                    int radius) {
+    grid_iter_start(iter, type, GRID_ITER_RINGS, center, center, radius,
+                    radius);
+}
+
+void grid_iter_spiral(grid_iter_t *iter, grid_type_e type, grid_cell_t center,
+                      int max_radius) {
+    grid_iter_start(iter, type, GRID_ITER_RINGS, center, center, 0,
+                    max_radius);
+}
+
+void grid_iter_line(grid_iter_t *iter, grid_type_e type, grid_cell_t start,
+                    grid_cell_t end) {
+    int length = grid_geometry_distance(type, start, end);
+    if (end.type != type)
+        length = -1;
+    grid_iter_start(iter, type, GRID_ITER_LINE, start, end, 0, length);
+}
+
+bool grid_iter_next(grid_iter_t *iter, grid_cell_t *out_cell) {
+    if (!iter->vtable)
+        return false;
+    if (!iter->vtable->iter_next(iter, out_cell)) {
+        iter->vtable = NULL;
+        return false;
+    }
+    return true;
+}
+
 bool grid_geometry_cells_equal(grid_type_e type, grid_cell_t a, grid_cell_t b) {
     const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
     if (!vtable || !vtable->cells_equal) {
@@ -237,27 +397,64 @@ grid_cell_t grid_geometry_calculate_center(grid_type_e type, grid_cell_t *cells,
     // This is a simplistic approach that works for hex
     // Other grid types might need different approaches
     if (type == GRID_TYPE_HEXAGON) {
-        int sum_q = 0, sum_r = 0, sum_s = 0;
+        int64_t sums[3] = {0, 0, 0};
         for (size_t i = 0; i < cell_count; i++) {
             if (cells[i].type != GRID_TYPE_HEXAGON) {
                 return (grid_cell_t){.type = GRID_TYPE_UNKNOWN};
             }
-            sum_q += cells[i].coord.hex.q;
-            sum_r += cells[i].coord.hex.r;
-            sum_s += cells[i].coord.hex.s;
+            sums[0] += cells[i].coord.hex.q;
+            sums[1] += cells[i].coord.hex.r;
+            sums[2] += cells[i].coord.hex.s;
         }
-
-        grid_cell_t center = {.type = GRID_TYPE_HEXAGON};
-        center.coord.hex.q = sum_q / (int)cell_count;
-        center.coord.hex.r = sum_r / (int)cell_count;
-        center.coord.hex.s = -(center.coord.hex.q + center.coord.hex.r);
-        return center;
+        return grid_geometry_center_from_sums(type, sums, cell_count);
     }
 
     // Default: return first cell as a fallback
     return cells[0];
 }
 
+// Rounds sum / count to the nearest integer, halves up, in exact arithmetic
+static int64_t grid_geometry_round_mean(int64_t sum, int64_t count) {
+    int64_t twice = 2 * sum + count;
+    int64_t denominator = 2 * count;
+    int64_t quotient = twice / denominator;
+    if (twice % denominator != 0 && twice < 0)
+        quotient--; // Floor, not truncation
+    return quotient;
+}
+
+grid_cell_t grid_geometry_center_from_sums(grid_type_e type,
+                                           const int64_t sums[3],
+                                           size_t cell_count) {
+    if (type != GRID_TYPE_HEXAGON || !sums || cell_count == 0) {
+        return (grid_cell_t){.type = GRID_TYPE_UNKNOWN};
+    }
+
+    // Cube rounding: round each axis, then rebuild the one that moved most
+    // from the exact mean so the three still sum to zero. Distances are
+    // compared scaled by the count, which keeps them integers.
+    int64_t count = (int64_t)cell_count;
+    int64_t rounded[3];
+    int64_t moved[3];
+    for (int axis = 0; axis < 3; axis++) {
+        rounded[axis] = grid_geometry_round_mean(sums[axis], count);
+        moved[axis] = llabs(rounded[axis] * count - sums[axis]);
+    }
+    if (moved[0] > moved[1] && moved[0] > moved[2]) {
+        rounded[0] = -rounded[1] - rounded[2];
+    } else if (moved[1] > moved[2]) {
+        rounded[1] = -rounded[0] - rounded[2];
+    } else {
+        rounded[2] = -rounded[0] - rounded[1];
+    }
+
+    grid_cell_t center = {.type = GRID_TYPE_HEXAGON};
+    center.coord.hex.q = (int)rounded[0];
+    center.coord.hex.r = (int)rounded[1];
+    center.coord.hex.s = (int)rounded[2];
+    return center;
+}
+
 int grid_geometry_count_external_edges(grid_type_e type, grid_cell_t *cells,
                                        size_t cell_count) {
     if (!cells || cell_count == 0) {
@@ -354,33 +551,85 @@ bool grid_geometry_calculate_bounds(grid_type_e type, const layout_t *layout,
     int corner_count = vtable->corner_count;
     float min_x = 1e6f, min_y = 1e6f, max_x = -1e6f, max_y = -1e6f;
 
-    // For each cell, get all corners and update bounds
-    for (size_t i = 0; i < cell_count; i++) {
-        point_t *corners = malloc(corner_count * sizeof(point_t));
-        if (!corners) {
-            return false;
+    // Fetch the corners of a block of cells at a time and update bounds
+    enum { BLOCK = 64 };
+    float corners[2 * GRID_MAX_CORNERS * BLOCK];
+    for (size_t begin = 0; begin < cell_count; begin += BLOCK) {
+        size_t n = cell_count - begin < BLOCK ? cell_count - begin : BLOCK;
+        grid_geometry_get_corners_batch(type, layout, cells + begin, n,
+                                        corners);
+
+        size_t point_count = n * (size_t)corner_count;
+        for (size_t j = 0; j < point_count; j++) {
+            float x = corners[2 * j];
+            float y = corners[2 * j + 1];
+            min_x = x < min_x ? x : min_x;
+            min_y = y < min_y ? y : min_y;
+            max_x = x > max_x ? x : max_x;
+            max_y = y > max_y ? y : max_y;
         }
+    }
 
-        vtable->get_corners(layout, cells[i], corners);
-
-        for (int j = 0; j < corner_count; j++) {
-            if (corners[j].x < min_x)
-                min_x = corners[j].x;
-            if (corners[j].y < min_y)
-                min_y = corners[j].y;
-            if (corners[j].x > max_x)
-                max_x = corners[j].x;
-            if (corners[j].y > max_y)
-                max_y = corners[j].y;
-        }
+    *out_min_x = min_x;
+    *out_min_y = min_y;
+    *out_max_x = max_x;
+    *out_max_y = max_y;
+
+    return true;
+}
 
-        free(corners);
+bool grid_geometry_region_bounds(grid_type_e type, const layout_t *layout,
+                                 grid_cell_t center, int radius,
+                                 float *out_min_x, float *out_min_y,
+                                 float *out_max_x, float *out_max_y) {
+    const grid_vtable_t *vtable = grid_geometry_get_vtable(type);
+    if (!vtable || radius < 0) {
+        return false;
+    }
+
+    if (vtable->get_region_corners) {
+        grid_cell_t corners[GRID_MAX_CORNERS];
+        int count = vtable->get_region_corners(center, radius, corners);
+        return grid_geometry_calculate_bounds(type, layout, corners,
+                                              (size_t)count, out_min_x,
+                                              out_min_y, out_max_x,
+                                              out_max_y);
+    }
+
+    // No closed form: walk the region a block of cells at a time
+    enum { BLOCK = 64 };
+    grid_cell_t block[BLOCK];
+    size_t block_count = 0;
+    bool has_bounds = false;
+    float min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    grid_iter_t iter;
+    grid_iter_range(&iter, type, center, radius);
+    for (;;) {
+        bool more = grid_iter_next(&iter, &block[block_count]);
+        if (more && ++block_count < BLOCK)
+            continue;
+
+        float bx0, by0, bx1, by1;
+        if (block_count > 0 &&
+            grid_geometry_calculate_bounds(type, layout, block, block_count,
+                                           &bx0, &by0, &bx1, &by1)) {
+            min_x = has_bounds && min_x < bx0 ? min_x : bx0;
+            min_y = has_bounds && min_y < by0 ? min_y : by0;
+            max_x = has_bounds && max_x > bx1 ? max_x : bx1;
+            max_y = has_bounds && max_y > by1 ? max_y : by1;
+            has_bounds = true;
+        }
+        block_count = 0;
+        if (!more)
+            break;
+    }
+    if (!has_bounds || !out_min_x || !out_min_y || !out_max_x || !out_max_y) {
+        return false;
     }
 
     *out_min_x = min_x;
     *out_min_y = min_y;
     *out_max_x = max_x;
     *out_max_y = max_y;
-
     return true;
 }
@@ -1,9 +1,20 @@
 #include "../../include/grid/grid_geometry.h"
+#include "../../include/grid/hex_kernels.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HEX_GEOMETRY_SSE2
+#include <emmintrin.h>
+#endif
+
+#define HEX_PIXEL_BLOCK 64 // Cells gathered per pass of the batched kernel
+
 // --- Hex-specific definitions (private to this implementation) ---
 
 /**
@@ -32,10 +43,6 @@ typedef enum {
 
 // --- Static helper functions ---
 
-static int hex_distance_internal(hex_coord_t a, hex_coord_t b) {
-  return (abs(a.q - b.q) + abs(a.q + a.r - b.q - b.r) + abs(a.r - b.r)) / 2;
-}
-
 static hex_coord_t hex_round(double fq, double fr, double fs) {
   int q = (int)round(fq);
   int r = (int)round(fr);
@@ -73,6 +80,99 @@ static point_t hex_cell_to_pixel(const layout_t *layout, grid_cell_t cell) {
                    (y * layout->scale) + layout->origin.y};
 }
 
+// Converts a block of cells held as separate q and r columns, writing x and
+// y interleaved. Pixel = q * q_axis + r * r_axis + origin, with both axes
+// already scaled by the layout.
+static void hex_pixels_from_columns(const float *q, const float *r, size_t n,
+                                    point_t q_axis, point_t r_axis,
+                                    point_t origin, float *out_xy) {
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  __m256 qx = _mm256_set1_ps((float)q_axis.x);
+  __m256 qy = _mm256_set1_ps((float)q_axis.y);
+  __m256 rx = _mm256_set1_ps((float)r_axis.x);
+  __m256 ry = _mm256_set1_ps((float)r_axis.y);
+  __m256 ox = _mm256_set1_ps((float)origin.x);
+  __m256 oy = _mm256_set1_ps((float)origin.y);
+  for (; i + 8 <= n; i += 8) {
+    __m256 vq = _mm256_loadu_ps(q + i);
+    __m256 vr = _mm256_loadu_ps(r + i);
+    __m256 x =
+      _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vq, qx), _mm256_mul_ps(vr, rx)),
+                    ox);
+    __m256 y =
+      _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vq, qy), _mm256_mul_ps(vr, ry)),
+                    oy);
+    // Unpacking interleaves within each 128-bit half; the permutes put the
+    // halves back in cell order
+    __m256 lo = _mm256_unpacklo_ps(x, y);
+    __m256 hi = _mm256_unpackhi_ps(x, y);
+    _mm256_storeu_ps(out_xy + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(out_xy + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+#elif defined(HEX_GEOMETRY_SSE2)
+  __m128 qx = _mm_set1_ps((float)q_axis.x);
+  __m128 qy = _mm_set1_ps((float)q_axis.y);
+  __m128 rx = _mm_set1_ps((float)r_axis.x);
+  __m128 ry = _mm_set1_ps((float)r_axis.y);
+  __m128 ox = _mm_set1_ps((float)origin.x);
+  __m128 oy = _mm_set1_ps((float)origin.y);
+  for (; i + 4 <= n; i += 4) {
+    __m128 vq = _mm_loadu_ps(q + i);
+    __m128 vr = _mm_loadu_ps(r + i);
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vq, qx), _mm_mul_ps(vr, rx)), ox);
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vq, qy), _mm_mul_ps(vr, ry)), oy);
+    _mm_storeu_ps(out_xy + 2 * i, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(out_xy + 2 * i + 4, _mm_unpackhi_ps(x, y));
+  }
+#endif
+
+  // Scalar fallback and remainder
+  for (; i < n; i++) {
+    out_xy[2 * i] = q[i] * (float)q_axis.x + r[i] * (float)r_axis.x +
+                    (float)origin.x;
+    out_xy[2 * i + 1] = q[i] * (float)q_axis.y + r[i] * (float)r_axis.y +
+                        (float)origin.y;
+  }
+}
+
+static void hex_cells_to_pixels(const layout_t *layout,
+                                const grid_cell_t *cells, size_t count,
+                                float *out_xy) {
+  const orientation_t *M = &layout->orientation;
+  double sx = layout->size.x * layout->scale;
+  double sy = layout->size.y * layout->scale;
+  point_t q_axis = {M->f0 * sx, M->f2 * sy};
+  point_t r_axis = {M->f1 * sx, M->f3 * sy};
+
+  // Gather the coordinates into columns a block at a time, so the kernel
+  // reads contiguous floats
+  float q[HEX_PIXEL_BLOCK];
+  float r[HEX_PIXEL_BLOCK];
+  for (size_t begin = 0; begin < count; begin += HEX_PIXEL_BLOCK) {
+    size_t n = count - begin < HEX_PIXEL_BLOCK ? count - begin : HEX_PIXEL_BLOCK;
+    const grid_cell_t *block = cells + begin;
+    bool mixed = false;
+    for (size_t i = 0; i < n; i++) {
+      q[i] = (float)block[i].coord.hex.q;
+      r[i] = (float)block[i].coord.hex.r;
+      mixed |= block[i].type != GRID_TYPE_HEXAGON;
+    }
+
+    float *out = out_xy + 2 * begin;
+    hex_pixels_from_columns(q, r, n, q_axis, r_axis, layout->origin, out);
+
+    // Match hex_cell_to_pixel, which maps other cell types to (0, 0)
+    if (mixed) {
+      for (size_t i = 0; i < n; i++) {
+        if (block[i].type != GRID_TYPE_HEXAGON)
+          out[2 * i] = out[2 * i + 1] = 0.0f;
+      }
+    }
+  }
+}
+
 static grid_cell_t hex_pixel_to_cell(const layout_t *layout, point_t p) {
   const orientation_t *M = &layout->orientation;
 
@@ -92,19 +192,13 @@ static grid_cell_t hex_pixel_to_cell(const layout_t *layout, point_t p) {
 
 static void hex_get_neighbor(grid_cell_t cell, int direction,
                              grid_cell_t *out_neighbor) {
-  static const int dq[6] = {1, 1, 0, -1, -1, 0};
-  static const int dr[6] = {0, -1, -1, 0, 1, 1};
-  static const int ds[6] = {-1, 0, 1, 1, 0, -1};
-
   if (!out_neighbor || cell.type != GRID_TYPE_HEXAGON || direction < 0 ||
       direction >= 6) {
     return;
   }
 
-  *out_neighbor = cell;
-  out_neighbor->coord.hex.q += dq[direction];
-  out_neighbor->coord.hex.r += dr[direction];
-  out_neighbor->coord.hex.s += ds[direction];
+  *out_neighbor =
+    hex_kernel_cell(hex_kernel_neighbor(cell.coord.hex, direction));
 }
 
 static void hex_get_all_neighbors(grid_cell_t cell,
@@ -113,9 +207,122 @@ static void hex_get_all_neighbors(grid_cell_t cell,
     return;
   }
 
-  for (int dir = 0; dir < 6; dir++) {
-    hex_get_neighbor(cell, dir, &out_neighbors[dir]);
+  hex_kernel_all_neighbors(cell.coord.hex, out_neighbors);
+}
+
+// --- Iterators ---
+
+// First r of column q in a range walk
+static int hex_range_r_min(int range, int q) {
+  return -q - range > -range ? -q - range : -range;
+}
+
+static void hex_iter_begin(grid_iter_t *iter) {
+  switch (iter->kind) {
+  case GRID_ITER_RANGE:
+    // The cursor holds the next offset from the center, column by column
+    iter->cursor = hex_kernel_cell((hex_coord_t){
+      -iter->max_radius, hex_range_r_min(iter->max_radius, -iter->max_radius),
+      0});
+    break;
+  case GRID_ITER_RINGS:
+    iter->radius = iter->min_radius;
+    iter->cursor = hex_kernel_cell(
+      hex_kernel_ring_cell(iter->center.coord.hex, iter->radius, 0));
+    break;
+  case GRID_ITER_LINE:
+    break;
+  }
+  iter->index = 0;
+}
+
+static bool hex_iter_next_range(grid_iter_t *iter, grid_cell_t *out_cell) {
+  int range = iter->max_radius;
+  int q = iter->cursor.coord.hex.q;
+  int r = iter->cursor.coord.hex.r;
+  if (q > range)
+    return false;
+
+  *out_cell = hex_kernel_cell(
+    hex_kernel_apply(iter->center.coord.hex, (hex_coord_t){q, r, -q - r}));
+
+  int r_max = range - q < range ? range - q : range;
+  if (++r > r_max) {
+    q++;
+    r = hex_range_r_min(range, q);
   }
+  iter->cursor.coord.hex.q = q;
+  iter->cursor.coord.hex.r = r;
+  return true;
+}
+
+// Walks each ring the way hex_kernel_ring_cell numbers it, stepping to the
+// next ring's first cell when one is done
+static bool hex_iter_next_ring(grid_iter_t *iter, grid_cell_t *out_cell) {
+  if (iter->radius > iter->max_radius)
+    return false;
+
+  *out_cell = iter->cursor;
+  int radius = iter->radius;
+  if (radius > 0) {
+    iter->cursor.coord.hex =
+      hex_kernel_neighbor(iter->cursor.coord.hex, iter->index / radius);
+    if (++iter->index < 6 * radius)
+      return true;
+  }
+
+  iter->radius++;
+  iter->index = 0;
+  iter->cursor = hex_kernel_cell(
+    hex_kernel_ring_cell(iter->center.coord.hex, iter->radius, 0));
+  return true;
+}
+
+static bool hex_iter_next_line(grid_iter_t *iter, grid_cell_t *out_cell) {
+  int distance = iter->max_radius;
+  int i = iter->index;
+  if (i > distance)
+    return false;
+
+  hex_coord_t a = iter->center.coord.hex;
+  hex_coord_t b = iter->end.coord.hex;
+  double t = distance == 0 ? 0 : (double)i / distance;
+  double q = a.q + (b.q - a.q) * t;
+  double r = a.r + (b.r - a.r) * t;
+  double s = a.s + (b.s - a.s) * t;
+  *out_cell = hex_kernel_cell(hex_round(q, r, s));
+  iter->index++;
+  return true;
+}
+
+static bool hex_iter_next(grid_iter_t *iter, grid_cell_t *out_cell) {
+  switch (iter->kind) {
+  case GRID_ITER_RANGE:
+    return hex_iter_next_range(iter, out_cell);
+  case GRID_ITER_RINGS:
+    return hex_iter_next_ring(iter, out_cell);
+  case GRID_ITER_LINE:
+    return hex_iter_next_line(iter, out_cell);
+  }
+  return false;
+}
+
+// Drains an iterator into a new array of 'total' cells; the array-returning
+// functions below are thin wrappers over it
+static void hex_collect(grid_iter_t *iter, size_t total,
+                        grid_cell_t **out_cells, size_t *out_count) {
+  *out_count = 0;
+  *out_cells = malloc(total * sizeof(grid_cell_t));
+  if (!*out_cells) {
+    return;
+  }
+
+  size_t count = 0;
+  while (count < total && iter->vtable &&
+         hex_iter_next(iter, &(*out_cells)[count])) {
+    count++;
+  }
+  *out_count = count;
 }
 
 static void hex_get_cells_in_range(grid_cell_t center, int range,
@@ -134,31 +341,10 @@ static void hex_get_cells_in_range(grid_cell_t center, int range,
     return;
   }
 
-  // Calculate total cells in range
-  size_t total = 3 * range * (range + 1) + 1;
-  *out_cells = malloc(total * sizeof(grid_cell_t));
-  if (!*out_cells) {
-    *out_count = 0;
-    return;
-  }
-
-  size_t count = 0;
-  hex_coord_t c = center.coord.hex;
-
-  for (int q = -range; q <= range; q++) {
-    for (int r = -range; r <= range; r++) {
-      int s = -q - r;
-      if (abs(s) <= range) {
-        (*out_cells)[count].type = GRID_TYPE_HEXAGON;
-        (*out_cells)[count].coord.hex.q = c.q + q;
-        (*out_cells)[count].coord.hex.r = c.r + r;
-        (*out_cells)[count].coord.hex.s = c.s + s;
-        count++;
-      }
-    }
-  }
-
-  *out_count = count;
+  grid_iter_t iter;
+  grid_iter_range(&iter, GRID_TYPE_HEXAGON, center, range);
+  hex_collect(&iter, 3 * (size_t)range * (range + 1) + 1, out_cells,
+              out_count);
 }
 
 static bool hex_rotate_cell(grid_cell_t cell, int rotations,
@@ -168,20 +354,7 @@ static bool hex_rotate_cell(grid_cell_t cell, int rotations,
   }
   printf("rotations %d\n", rotations);
 
-  hex_coord_t h = cell.coord.hex;
-  rotations = ((rotations % 6) + 6) % 6; // Normalize to 0-5
-
-  for (int i = 0; i < rotations; i++) {
-    int new_q = -h.r;
-    int new_r = -h.s;
-    int new_s = -h.q;
-    h.q = new_q;
-    h.r = new_r;
-    h.s = new_s;
-  }
-
-  out_cell->type = GRID_TYPE_HEXAGON;
-  out_cell->coord.hex = h;
+  *out_cell = hex_kernel_cell(hex_kernel_rotate(cell.coord.hex, rotations));
   return true;
 }
 
@@ -189,7 +362,20 @@ static int hex_distance(grid_cell_t a, grid_cell_t b) {
   if (a.type != GRID_TYPE_HEXAGON || b.type != GRID_TYPE_HEXAGON) {
     return -1;
   }
-  return hex_distance_internal(a.coord.hex, b.coord.hex);
+  return hex_kernel_distance(a.coord.hex, b.coord.hex);
+}
+
+static void hex_get_corner_offsets(const layout_t *layout, point_t *offsets) {
+  if (!offsets) {
+    return;
+  }
+
+  const orientation_t *M = &layout->orientation;
+  for (int i = 0; i < 6; i++) {
+    double angle = 2.0 * M_PI * (M->start_angle + i) / 6.0;
+    offsets[i].x = layout->size.x * layout->scale * cos(angle);
+    offsets[i].y = layout->size.y * layout->scale * sin(angle);
+  }
 }
 
 static void hex_get_corners(const layout_t *layout, grid_cell_t cell,
@@ -199,12 +385,16 @@ static void hex_get_corners(const layout_t *layout, grid_cell_t cell,
   }
 
   point_t center = hex_cell_to_pixel(layout, cell);
-  const orientation_t *M = &layout->orientation;
+  point_t computed[6];
+  const point_t *offsets = layout->corner_offsets;
+  if (!grid_geometry_layout_corners_current(layout)) {
+    hex_get_corner_offsets(layout, computed);
+    offsets = computed;
+  }
 
   for (int i = 0; i < 6; i++) {
-    double angle = 2.0 * M_PI * (M->start_angle + i) / 6.0;
-    corners[i].x = center.x + layout->size.x * layout->scale * cos(angle);
-    corners[i].y = center.y + layout->size.y * layout->scale * sin(angle);
+    corners[i].x = center.x + offsets[i].x;
+    corners[i].y = center.y + offsets[i].y;
   }
 }
 
@@ -216,9 +406,7 @@ static grid_cell_t hex_calculate_offset(grid_cell_t from, grid_cell_t to) {
     return offset;
   }
 
-  offset.coord.hex.q = to.coord.hex.q - from.coord.hex.q;
-  offset.coord.hex.r = to.coord.hex.r - from.coord.hex.r;
-  offset.coord.hex.s = to.coord.hex.s - from.coord.hex.s;
+  offset.coord.hex = hex_kernel_offset(from.coord.hex, to.coord.hex);
 
   return offset;
 }
@@ -231,9 +419,7 @@ static grid_cell_t hex_apply_offset(grid_cell_t cell, grid_cell_t offset) {
     return result;
   }
 
-  result.coord.hex.q = cell.coord.hex.q + offset.coord.hex.q;
-  result.coord.hex.r = cell.coord.hex.r + offset.coord.hex.r;
-  result.coord.hex.s = cell.coord.hex.s + offset.coord.hex.s;
+  result.coord.hex = hex_kernel_apply(cell.coord.hex, offset.coord.hex);
 
   return result;
 }
@@ -246,6 +432,24 @@ static grid_cell_t hex_get_origin(void) {
   return origin;
 }
 
+static int hex_get_region_corners(grid_cell_t center, int radius,
+                                  grid_cell_t *out_cells) {
+  if (!out_cells || radius < 0 || center.type != GRID_TYPE_HEXAGON)
+    return 0;
+  if (radius == 0) {
+    out_cells[0] = center;
+    return 1;
+  }
+  for (int d = 0; d < 6; d++) {
+    hex_coord_t step = hex_kernel_direction(d);
+    hex_coord_t corner = {center.coord.hex.q + radius * step.q,
+                          center.coord.hex.r + radius * step.r,
+                          center.coord.hex.s + radius * step.s};
+    out_cells[d] = hex_kernel_cell(corner);
+  }
+  return 6;
+}
+
 static void hex_get_ring(grid_cell_t center, int radius,
                          grid_cell_t **out_cells, size_t *out_count) {
   if (!out_cells || !out_count || radius < 0) {
@@ -262,41 +466,10 @@ static void hex_get_ring(grid_cell_t center, int radius,
     return;
   }
 
-  if (radius == 0) {
-    *out_cells = malloc(sizeof(grid_cell_t));
-    if (*out_cells) {
-      (*out_cells)[0] = center;
-      *out_count = 1;
-    } else {
-      *out_count = 0;
-    }
-    return;
-  }
-
-  size_t total = 6 * radius;
-  *out_cells = malloc(total * sizeof(grid_cell_t));
-  if (!*out_cells) {
-    *out_count = 0;
-    return;
-  }
-
-  size_t count = 0;
-
-  // Start at a corner and walk around the ring
-  grid_cell_t current = center;
-  for (int i = 0; i < radius; i++) {
-    hex_get_neighbor(current, 4, &current); // Move SW to get to starting corner
-  }
-
-  // Walk around the ring
-  for (int side = 0; side < 6; side++) {
-    for (int step = 0; step < radius; step++) {
-      (*out_cells)[count++] = current;
-      hex_get_neighbor(current, side, &current);
-    }
-  }
-
-  *out_count = count;
+  grid_iter_t iter;
+  grid_iter_ring(&iter, GRID_TYPE_HEXAGON, center, radius);
+  hex_collect(&iter, radius == 0 ? 1 : 6 * (size_t)radius, out_cells,
+              out_count);
 }
 
 static void hex_get_line(grid_cell_t start, grid_cell_t end,
@@ -315,26 +488,10 @@ static void hex_get_line(grid_cell_t start, grid_cell_t end,
     return;
   }
 
-  int distance = hex_distance(start, end);
-  size_t total = distance + 1;
-
-  *out_cells = malloc(total * sizeof(grid_cell_t));
-  if (!*out_cells) {
-    *out_count = 0;
-    return;
-  }
-
-  for (int i = 0; i <= distance; i++) {
-    double t = distance == 0 ? 0 : (double)i / distance;
-    double q = start.coord.hex.q + (end.coord.hex.q - start.coord.hex.q) * t;
-    double r = start.coord.hex.r + (end.coord.hex.r - start.coord.hex.r) * t;
-    double s = start.coord.hex.s + (end.coord.hex.s - start.coord.hex.s) * t;
-
-    (*out_cells)[i].type = GRID_TYPE_HEXAGON;
-    (*out_cells)[i].coord.hex = hex_round(q, r, s);
-  }
-
-  *out_count = total;
+  grid_iter_t iter;
+  grid_iter_line(&iter, GRID_TYPE_HEXAGON, start, end);
+  hex_collect(&iter, (size_t)hex_distance(start, end) + 1, out_cells,
+              out_count);
 }
 
 static bool hex_cells_equal(grid_cell_t a, grid_cell_t b) {
@@ -432,8 +589,19 @@ static grid_cell_t hex_get_edge_neighbor(grid_cell_t cell,
 
 static void hex_get_spiral(grid_cell_t center, int max_radius,
                            grid_cell_t **out_cells, size_t *out_count) {
-  hex_get_cells_in_range(center, max_radius, out_cells, out_count);
-  // Could implement actual spiral ordering if needed
+  if (!out_cells || !out_count || max_radius < 0 ||
+      center.type != GRID_TYPE_HEXAGON) {
+    if (out_count)
+      *out_count = 0;
+    if (out_cells)
+      *out_cells = NULL;
+    return;
+  }
+
+  grid_iter_t iter;
+  grid_iter_spiral(&iter, GRID_TYPE_HEXAGON, center, max_radius);
+  hex_collect(&iter, 3 * (size_t)max_radius * (max_radius + 1) + 1, out_cells,
+              out_count);
 }
 
 static grid_cell_t hex_rotate_around(grid_cell_t cell, grid_cell_t center,
@@ -490,11 +658,17 @@ const grid_vtable_t hex_grid_vtable = {
   .rotate_cell = hex_rotate_cell,
   .distance = hex_distance,
   .get_corners = hex_get_corners,
+  .get_corner_offsets = hex_get_corner_offsets,
+  .cells_to_pixels = hex_cells_to_pixels,
   .calculate_offset = hex_calculate_offset,
   .apply_offset = hex_apply_offset,
   .get_origin = hex_get_origin,
   .get_ring = hex_get_ring,
   .get_line = hex_get_line,
+  .get_spiral = hex_get_spiral,
+  .get_region_corners = hex_get_region_corners,
+  .iter_begin = hex_iter_begin,
+  .iter_next = hex_iter_next,
   .cells_equal = hex_cells_equal,
   .get_cell_mesh = hex_get_cell_mesh,
   .neighbor_count = 6,
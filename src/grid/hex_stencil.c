@@ -0,0 +1,53 @@
+#include "../../include/grid/hex_stencil.h"
+
+// Generated by walking each ring like hex_kernel_ring_cell: start 'radius'
+// steps SW of the center, then 'radius' steps in each direction 0..5.
+const hex_stencil_offset_t hex_stencil_offsets[HEX_STENCIL_SIZE] = {
+  // Ring 0
+  {0, 0},
+  // Ring 1
+  {-1, 1}, {0, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, 0},
+  // Ring 2
+  {-2, 2}, {-1, 2}, {0, 2}, {1, 1}, {2, 0}, {2, -1}, {2, -2}, {1, -2}, {0, -2},
+  {-1, -1}, {-2, 0}, {-2, 1},
+  // Ring 3
+  {-3, 3}, {-2, 3}, {-1, 3}, {0, 3}, {1, 2}, {2, 1}, {3, 0}, {3, -1}, {3, -2},
+  {3, -3}, {2, -3}, {1, -3}, {0, -3}, {-1, -2}, {-2, -1}, {-3, 0}, {-3, 1},
+  {-3, 2},
+  // Ring 4
+  {-4, 4}, {-3, 4}, {-2, 4}, {-1, 4}, {0, 4}, {1, 3}, {2, 2}, {3, 1}, {4, 0},
+  {4, -1}, {4, -2}, {4, -3}, {4, -4}, {3, -4}, {2, -4}, {1, -4}, {0, -4},
+  {-1, -3}, {-2, -2}, {-3, -1}, {-4, 0}, {-4, 1}, {-4, 2}, {-4, 3},
+  // Ring 5
+  {-5, 5}, {-4, 5}, {-3, 5}, {-2, 5}, {-1, 5}, {0, 5}, {1, 4}, {2, 3}, {3, 2},
+  {4, 1}, {5, 0}, {5, -1}, {5, -2}, {5, -3}, {5, -4}, {5, -5}, {4, -5}, {3, -5},
+  {2, -5}, {1, -5}, {0, -5}, {-1, -4}, {-2, -3}, {-3, -2}, {-4, -1}, {-5, 0},
+  {-5, 1}, {-5, 2}, {-5, 3}, {-5, 4},
+  // Ring 6
+  {-6, 6}, {-5, 6}, {-4, 6}, {-3, 6}, {-2, 6}, {-1, 6}, {0, 6}, {1, 5}, {2, 4},
+  {3, 3}, {4, 2}, {5, 1}, {6, 0}, {6, -1}, {6, -2}, {6, -3}, {6, -4}, {6, -5},
+  {6, -6}, {5, -6}, {4, -6}, {3, -6}, {2, -6}, {1, -6}, {0, -6}, {-1, -5},
+  {-2, -4}, {-3, -3}, {-4, -2}, {-5, -1}, {-6, 0}, {-6, 1}, {-6, 2}, {-6, 3},
+  {-6, 4}, {-6, 5},
+  // Ring 7
+  {-7, 7}, {-6, 7}, {-5, 7}, {-4, 7}, {-3, 7}, {-2, 7}, {-1, 7}, {0, 7}, {1, 6},
+  {2, 5}, {3, 4}, {4, 3}, {5, 2}, {6, 1}, {7, 0}, {7, -1}, {7, -2}, {7, -3},
+  {7, -4}, {7, -5}, {7, -6}, {7, -7}, {6, -7}, {5, -7}, {4, -7}, {3, -7},
+  {2, -7}, {1, -7}, {0, -7}, {-1, -6}, {-2, -5}, {-3, -4}, {-4, -3}, {-5, -2},
+  {-6, -1}, {-7, 0}, {-7, 1}, {-7, 2}, {-7, 3}, {-7, 4}, {-7, 5}, {-7, 6},
+  // Ring 8
+  {-8, 8}, {-7, 8}, {-6, 8}, {-5, 8}, {-4, 8}, {-3, 8}, {-2, 8}, {-1, 8},
+  {0, 8}, {1, 7}, {2, 6}, {3, 5}, {4, 4}, {5, 3}, {6, 2}, {7, 1}, {8, 0},
+  {8, -1}, {8, -2}, {8, -3}, {8, -4}, {8, -5}, {8, -6}, {8, -7}, {8, -8},
+  {7, -8}, {6, -8}, {5, -8}, {4, -8}, {3, -8}, {2, -8}, {1, -8}, {0, -8},
+  {-1, -7}, {-2, -6}, {-3, -5}, {-4, -4}, {-5, -3}, {-6, -2}, {-7, -1}, {-8, 0},
+  {-8, 1}, {-8, 2}, {-8, 3}, {-8, 4}, {-8, 5}, {-8, 6}, {-8, 7},
+  // Ring 9
+  {-9, 9}, {-8, 9}, {-7, 9}, {-6, 9}, {-5, 9}, {-4, 9}, {-3, 9}, {-2, 9},
+  {-1, 9}, {0, 9}, {1, 8}, {2, 7}, {3, 6}, {4, 5}, {5, 4}, {6, 3}, {7, 2},
+  {8, 1}, {9, 0}, {9, -1}, {9, -2}, {9, -3}, {9, -4}, {9, -5}, {9, -6}, {9, -7},
+  {9, -8}, {9, -9}, {8, -9}, {7, -9}, {6, -9}, {5, -9}, {4, -9}, {3, -9},
+  {2, -9}, {1, -9}, {0, -9}, {-1, -8}, {-2, -7}, {-3, -6}, {-4, -5}, {-5, -4},
+  {-6, -3}, {-7, -2}, {-8, -1}, {-9, 0}, {-9, 1}, {-9, 2}, {-9, 3}, {-9, 4},
+  {-9, 5}, {-9, 6}, {-9, 7}, {-9, 8}
+};
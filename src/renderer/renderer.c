@@ -78,40 +78,25 @@ void render_hex_cells_batched(const board_t *board, grid_cell_t *cells,
 
   Color ray_fill_color = to_raylib_color(fill_color);
 
-  // Use batched approach: collect all vertices for this color and draw with
-  // minimal calls
-  Vector2 *vertices = malloc(count * 6 * sizeof(Vector2));
-  if (!vertices)
-    return;
-
-  size_t batch_size = 0;
-  const size_t MAX_BATCH = 1000; // Process in batches to avoid memory issues
-
-  for (size_t i = 0; i < count; i++) {
-    point_t corners[6];
-    grid_geometry_get_corners(board->geometry_type, &board->layout, cells[i],
-                              corners);
-
-    Vector2 hex_verts[6];
-    for (int j = 0; j < 6; j++) {
-      int reversed_j = (6 - 1) - j;
-      hex_verts[j] =
-        (Vector2){(float)corners[reversed_j].x, (float)corners[reversed_j].y};
-    }
-
-    // Draw this hex using triangle fan (most efficient for individual hexes)
-    DrawTriangleFan(hex_verts, 6, ray_fill_color);
-
-    batch_size++;
-
-    // If we hit batch limit, we could implement more sophisticated batching
-    // here
-    if (batch_size >= MAX_BATCH) {
-      batch_size = 0;
+  // Fetch the corners of a block of cells at once; Vector2 arrays share the
+  // interleaved x/y layout the batch writes
+  enum { BLOCK = 64 };
+  Vector2 corners[BLOCK * 6];
+  for (size_t begin = 0; begin < count; begin += BLOCK) {
+    size_t n = count - begin < BLOCK ? count - begin : BLOCK;
+    grid_geometry_get_corners_batch(board->geometry_type, &board->layout,
+                                    cells + begin, n, (float *)corners);
+
+    for (size_t i = 0; i < n; i++) {
+      const Vector2 *hex = corners + i * 6;
+      Vector2 hex_verts[6];
+      // Reverse vertex order for counter-clockwise winding
+      for (int j = 0; j < 6; j++) {
+        hex_verts[j] = hex[(6 - 1) - j];
+      }
+      DrawTriangleFan(hex_verts, 6, ray_fill_color);
     }
   }
-
-  free(vertices);
 }
 
 void render_board_batched(const board_t *board) {
@@ -136,9 +121,9 @@ void render_board_batched(const board_t *board) {
   }
 
   // Group tiles by type
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, board->tiles->root, entry, tmp) {
-    tile_t *tile = entry->tile;
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(board->tiles, tile, iter) {
     if (tile->data.type >= 0 && tile->data.type < TILE_TYPE_COUNT) {
       tile_group_t *group = &groups[tile->data.type];
 
@@ -212,36 +197,15 @@ void render_game_previews(const game_t *game) {
     game->preview.source_board->geometry_type, source_center,
     game->preview.target_position);
 
-  // Get conflicts using the simplified system
-  grid_cell_t *conflicts;
-  size_t conflict_count;
-  bool has_conflicts =
-    game_get_preview_conflicts(game, &conflicts, &conflict_count);
-
-  // Render all source tiles with preview colors
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, game->preview.source_board->tiles->root, entry, tmp) {
-    tile_t *source_tile = entry->tile;
+  // Bounds and conflicts come straight from the board's occupancy bitboard
+  tile_map_iter_t iter;
+  tile_t *source_tile;
+  TILE_MAP_ITER(game->preview.source_board->tiles, source_tile, iter) {
     grid_cell_t target_pos = grid_geometry_apply_offset(
       game->preview.source_board->geometry_type, source_tile->cell, offset);
 
-    // Check if this position is valid (within board bounds)
-    grid_cell_t origin = grid_geometry_get_origin(game->board->geometry_type);
-    int distance =
-      grid_geometry_distance(game->board->geometry_type, target_pos, origin);
-    bool is_valid_cell = (distance <= game->board->radius);
-
-    if (is_valid_cell) {
-      // Check if this position conflicts
-      bool is_conflict = false;
-      if (has_conflicts && conflicts) {
-        for (size_t i = 0; i < conflict_count; i++) {
-          if (grid_cells_equal(&target_pos, &conflicts[i])) {
-            is_conflict = true;
-            break;
-          }
-        }
-      }
+    if (board_cell_in_bounds(game->board, target_pos)) {
+      bool is_conflict = board_is_occupied(game->board, target_pos);
 
       if (is_conflict) {
         // Render conflict in red
@@ -258,33 +222,20 @@ void render_game_previews(const game_t *game) {
       }
     }
   }
-
-  // Free conflicts array if allocated
-  if (conflicts) {
-    free(conflicts);
-  }
 }
 
 void render_hex_grid(const board_t *board) {
   if (!board)
     return;
 
-  // Get all coordinates for this geometry type and radius
-  grid_cell_t *all_coords;
-  size_t coord_count;
+  // Stream every cell within the board radius
+  grid_iter_t iter;
+  grid_cell_t cell;
   grid_cell_t origin = grid_geometry_get_origin(board->geometry_type);
-  grid_geometry_get_cells_in_range(board->geometry_type, origin, board->radius,
-                                   &all_coords, &coord_count);
-  if (!all_coords || coord_count == 0) {
-    return;
+  grid_iter_range(&iter, board->geometry_type, origin, board->radius);
+  while (grid_iter_next(&iter, &cell)) {
+    render_hex_cell(board, cell, M_BLANK, M_GRAY);
   }
-
-  // Render grid outline
-  for (size_t i = 0; i < coord_count; i++) {
-    render_hex_cell(board, all_coords[i], M_BLANK, M_GRAY);
-  }
-
-  free(all_coords);
 }
 
 void render_board_in_bounds(const board_t *board, Rectangle bounds) {
@@ -292,27 +243,12 @@ void render_board_in_bounds(const board_t *board, Rectangle bounds) {
     return;
   }
 
-  // Get all coordinates to calculate board bounding box
-  grid_cell_t *all_coords;
-  size_t coord_count;
-  grid_cell_t origin = grid_geometry_get_origin(board->geometry_type);
-  grid_geometry_get_cells_in_range(board->geometry_type, origin, board->radius,
-                                   &all_coords, &coord_count);
-  if (!all_coords || coord_count == 0) {
-    return;
-  }
-
-  // Calculate board bounding box using the optimized function
+  // The bounds of the board's whole radius, in closed form
   float min_x, min_y, max_x, max_y;
-  if (!grid_geometry_calculate_bounds(board->geometry_type, &board->layout,
-                                      all_coords, coord_count, &min_x, &min_y,
-                                      &max_x, &max_y)) {
-    free(all_coords);
+  if (!board_region_bounds(board, &min_x, &min_y, &max_x, &max_y)) {
     return;
   }
 
-  free(all_coords);
-
   float board_width = max_x - min_x;
   float board_height = max_y - min_y;
 
@@ -1,12 +1,79 @@
 #include "../../include/tile/pool.h"
 #include "../../include/grid/grid_cell_utils.h"
 #include "../../include/grid/grid_geometry.h"
+#include "../../include/grid/hex_kernels.h"
 #include "../../include/third_party/uthash.h"
 #include "grid/grid_types.h"
 #include "third_party/kvec.h"
 #include "tile/tile_map.h"
 #include <complex.h>
+#include <limits.h>
 #include <stdio.h>
+#include <string.h>
+
+#define POOL_FRONTIER_SLAB_CHUNK 64
+
+static pool_frontier_entry_t *pool_frontier_find(const pool_t *pool,
+                                                 grid_cell_t cell) {
+    tile_map_key_t key = tile_map_key_from_cell(cell);
+    pool_frontier_entry_t *entry = NULL;
+    HASH_FIND(hh, pool->frontier, &key, sizeof(key), entry);
+    return entry;
+}
+
+// Adds 'amount' to a frontier cell's count, creating the cell if needed
+static void pool_frontier_add(pool_t *pool, grid_cell_t cell, int amount) {
+    pool_frontier_entry_t *entry = pool_frontier_find(pool, cell);
+    if (!entry) {
+        if (!pool->frontier_slab) {
+            pool->frontier_slab = slab_create(sizeof(pool_frontier_entry_t),
+                                              POOL_FRONTIER_SLAB_CHUNK);
+        }
+        entry = slab_alloc(pool->frontier_slab);
+        if (!entry)
+            return;
+        entry->key = tile_map_key_from_cell(cell);
+        entry->cell = cell;
+        entry->count = 0;
+        HASH_ADD(hh, pool->frontier, key, sizeof(entry->key), entry);
+    }
+    entry->count += amount;
+}
+
+static void pool_frontier_remove(pool_t *pool, pool_frontier_entry_t *entry) {
+    HASH_DEL(pool->frontier, entry);
+    slab_release(pool->frontier_slab, entry);
+}
+
+static void pool_extents_reset(pool_extents_t *extents) {
+    for (int axis = 0; axis < 3; axis++) {
+        extents->min[axis] = INT_MAX;
+        extents->max[axis] = INT_MIN;
+    }
+    extents->dirty = false;
+}
+
+static void pool_extents_include(pool_extents_t *extents, grid_cell_t cell) {
+    const int coords[3] = {cell.coord.hex.q, cell.coord.hex.r,
+                           cell.coord.hex.s};
+    for (int axis = 0; axis < 3; axis++) {
+        if (coords[axis] < extents->min[axis])
+            extents->min[axis] = coords[axis];
+        if (coords[axis] > extents->max[axis])
+            extents->max[axis] = coords[axis];
+    }
+}
+
+// Widest cube axis of the extents, which is the hex diameter of the cells
+static int pool_extents_span(const pool_extents_t *extents) {
+    int span = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        if (extents->max[axis] >= extents->min[axis] &&
+            extents->max[axis] - extents->min[axis] > span)
+            span = extents->max[axis] - extents->min[axis];
+    }
+    return span;
+}
 
 // LIFECYCLE
 pool_t *pool_create() {
@@ -25,40 +92,90 @@ pool_t *pool_create() {
     // Initialize geometric properties
     pool->diameter = 0;
     pool->edge_count = 0;
+    pool->internal_edge_count = 0;
     pool->compactness_score = 0.0f;
+    pool_extents_reset(&pool->extents);
+    memset(pool->coord_sums, 0, sizeof(pool->coord_sums));
+    memset(pool->neighbor_histogram, 0, sizeof(pool->neighbor_histogram));
 
-    // Initialize neighbor cells and tiles
-    kv_init(pool->neighbor_cells);
+    // Initialize the frontier and neighbor tiles
+    pool->frontier = NULL;
+    pool->frontier_slab = NULL;
     kv_init(pool->neighbor_tiles);
+    pool->neighbor_tiles_dirty = false;
+    pool->adjacent = NULL;
+    pool->score = 0.0f;
+    pool->score_dirty = true;
+    pool->leaderboard_index = 0;
 
     return pool;
 }
 
-void pool_update_center(pool_t *pool) {
+void pool_update_center(pool_t *pool, grid_type_e geometry_type) {
     if (!pool || !pool->tiles || pool->tiles->num_tiles == 0)
         return;
+    pool->center = pool_calculate_center(pool, geometry_type);
+}
 
-    // Find the center tile based on the average position of all tiles in the
-    // pool.
-    tile_map_entry_t *entry, *tmp;
-    grid_cell_t center_cell = {0};
-    int total_x = 0, total_y = 0, count = 0;
+// Adds (sign 1) or subtracts (sign -1) a cell's cube coordinates from the
+// pool's running sums
+static void pool_coord_sums_add(pool_t *pool, grid_cell_t cell, int sign) {
+    pool->coord_sums[0] += sign * cell.coord.hex.q;
+    pool->coord_sums[1] += sign * cell.coord.hex.r;
+    pool->coord_sums[2] += sign * cell.coord.hex.s;
+}
 
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        total_x += entry->cell.coord.square.x;
-        total_y += entry->cell.coord.square.y;
-        count++;
-    }
+bool pool_apply_transform(pool_t *pool, const tile_map_transform_t *transform) {
+    if (!pool || !transform)
+        return false;
+
+    if (!tile_map_reindex(pool->tiles))
+        return false;
 
-    if (count > 0) {
-        center_cell.coord.square.y = total_y / count;
-        center_cell.coord.square.x = total_x / count;
-        pool->center = center_cell;
+    // A cell maps to sign * rel[(steps + axis) % 3] + pivot + offset on each
+    // axis (see tile_map_transform_cell), so the coordinate sums and bounds
+    // map the same way in closed form and the center stays O(1)
+    int steps = ((transform->rotation_steps % 6) + 6) % 6;
+    int sign = (steps & 1) ? -1 : 1;
+    const hex_coord_t *pivot_hex = &transform->center.coord.hex;
+    const hex_coord_t *offset_hex = &transform->offset.coord.hex;
+    int pivot[3] = {pivot_hex->q, pivot_hex->r, pivot_hex->s};
+    int shift[3] = {pivot_hex->q + offset_hex->q, pivot_hex->r + offset_hex->r,
+                    pivot_hex->s + offset_hex->s};
+    int64_t n = (int64_t)pool->tiles->num_tiles;
+    int64_t sums[3];
+    pool_extents_t extents = pool->extents;
+    for (int axis = 0; axis < 3; axis++) {
+        int from = (steps + axis) % 3;
+        sums[axis] = sign * (pool->coord_sums[from] - n * pivot[from]) +
+                     n * shift[axis];
+        if (extents.dirty || n == 0)
+            continue;
+        // A sign flip swaps which bound is the minimum
+        int low = sign > 0 ? pool->extents.min[from] : pool->extents.max[from];
+        int high = sign > 0 ? pool->extents.max[from] : pool->extents.min[from];
+        extents.min[axis] = sign * (low - pivot[from]) + shift[axis];
+        extents.max[axis] = sign * (high - pivot[from]) + shift[axis];
     }
+    memcpy(pool->coord_sums, sums, sizeof(sums));
+    pool->extents = extents;
+    pool_update_center(pool, transform->center.type);
+
+    // Re-key the frontier under the moved cells, reusing its entries
+    pool_frontier_entry_t *entry, *tmp, *moved = NULL;
+    HASH_ITER(hh, pool->frontier, entry, tmp) {
+        HASH_DEL(pool->frontier, entry);
+        entry->cell = tile_map_transform_cell(transform, entry->cell);
+        entry->key = tile_map_key_from_cell(entry->cell);
+        HASH_ADD(hh, moved, key, sizeof(entry->key), entry);
+    }
+    pool->frontier = moved;
+    pool->neighbor_tiles_dirty = true;
+    return true;
 }
 
 bool pool_contains_tile(const pool_t *pool, const tile_t *tile_ptr) {
-    return tile_map_find(pool->tiles, tile_ptr->cell) != NULL;
+    return tile_map_contains(pool->tiles, tile_ptr->cell);
 }
 
 // --- Modifier Functions ---
@@ -66,12 +183,14 @@ bool pool_contains_tile(const pool_t *pool, const tile_t *tile_ptr) {
 void pool_set_modifier(pool_t *pool, float modifier) {
     if (pool) {
         pool->modifier = modifier;
+        pool->score_dirty = true;
     }
 }
 
 void pool_add_modifier(pool_t *pool, float modifier_delta) {
     if (pool) {
         pool->modifier += modifier_delta;
+        pool->score_dirty = true;
     }
 }
 
@@ -87,9 +206,308 @@ void pool_update_geometric_properties(pool_t *pool, grid_type_e geometry_type) {
 
     size_t old_tile_count = pool->tiles ? pool->tiles->num_tiles : 0;
 
+    // Edge counters and extents are maintained incrementally; see
+    // pool_track_tile_added
+    pool_refresh_extents(pool);
     pool->diameter = pool_calculate_diameter(pool, geometry_type);
-    pool->edge_count = pool_calculate_edge_count(pool, geometry_type);
     pool->compactness_score = pool_calculate_compactness_score(pool);
+    pool->highest_n = pool_find_max_tile_neighbors_in_pool(pool, geometry_type);
+    pool_update_center(pool, geometry_type);
+
+#ifdef POOL_VERIFY_EDGES
+    pool_verify_edge_counts(pool, geometry_type);
+#endif
+}
+
+// Counts the tile's neighbors that are in the pool. A tile is never its own
+// neighbor, so this does not depend on whether the tile is in the map.
+static int pool_count_member_neighbors(const pool_t *pool, const tile_t *tile,
+                                       grid_type_e geometry_type) {
+    int num_neighbors = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbors[num_neighbors];
+    hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbors);
+
+    int shared = 0;
+    for (int i = 0; i < num_neighbors; i++) {
+        if (tile_map_contains(pool->tiles, neighbors[i]))
+            shared++;
+    }
+    return shared;
+}
+
+void pool_track_tile_added(pool_t *pool, const tile_t *tile,
+                           grid_type_e geometry_type) {
+    if (!pool || !tile)
+        return;
+    // The tile's cell leaves the frontier; its other neighbors join it
+    pool_frontier_entry_t *own = pool_frontier_find(pool, tile->cell);
+    if (own)
+        pool_frontier_remove(pool, own);
+
+    int num_neighbors = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbors[num_neighbors];
+    hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbors);
+    int shared = 0;
+    for (int i = 0; i < num_neighbors; i++) {
+        if (tile_map_contains(pool->tiles, neighbors[i]))
+            shared++;
+        else
+            pool_frontier_add(pool, neighbors[i], 1);
+    }
+    pool->neighbor_tiles_dirty = true;
+
+    // Each shared side turns one of the pool's external edges internal and
+    // costs the new tile one of its own
+    pool->internal_edge_count += shared;
+    pool->edge_count +=
+      grid_geometry_get_neighbor_count(geometry_type) - 2 * shared;
+    pool->neighbor_histogram[tile_same_type_neighbor_count(tile)]++;
+    pool_coord_sums_add(pool, tile->cell, 1);
+    pool->score_dirty = true;
+
+    if (!pool->extents.dirty)
+        pool_extents_include(&pool->extents, tile->cell);
+}
+
+void pool_track_tile_removed(pool_t *pool, const tile_t *tile,
+                             grid_type_e geometry_type) {
+    if (!pool || !tile)
+        return;
+    // Neighbors outside the pool lose one reference; the tile's own cell
+    // joins the frontier if it still touches the pool
+    int num_neighbors = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbors[num_neighbors];
+    hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbors);
+    int shared = 0;
+    for (int i = 0; i < num_neighbors; i++) {
+        if (tile_map_contains(pool->tiles, neighbors[i])) {
+            shared++;
+            continue;
+        }
+        pool_frontier_entry_t *entry = pool_frontier_find(pool, neighbors[i]);
+        if (entry && --entry->count <= 0)
+            pool_frontier_remove(pool, entry);
+    }
+    if (shared > 0)
+        pool_frontier_add(pool, tile->cell, shared);
+    pool->neighbor_tiles_dirty = true;
+
+    pool->internal_edge_count -= shared;
+    pool->edge_count -=
+      grid_geometry_get_neighbor_count(geometry_type) - 2 * shared;
+    pool->neighbor_histogram[tile_same_type_neighbor_count(tile)]--;
+    pool_coord_sums_add(pool, tile->cell, -1);
+    pool->score_dirty = true;
+
+    // Only a tile sitting on a bound can shrink the extents
+    const int coords[3] = {tile->cell.coord.hex.q, tile->cell.coord.hex.r,
+                           tile->cell.coord.hex.s};
+    for (int axis = 0; axis < 3; axis++) {
+        if (coords[axis] == pool->extents.min[axis] ||
+            coords[axis] == pool->extents.max[axis])
+            pool->extents.dirty = true;
+    }
+}
+
+void pool_track_merge(pool_t *keep, const pool_t *absorbed,
+                      grid_type_e geometry_type) {
+    if (!keep || !absorbed)
+        return;
+    // Absorbed frontier cells count toward keep unless keep owns them, and
+    // keep's frontier cells that are absorbed tiles stop being frontier
+    pool_frontier_entry_t *entry, *tmp;
+    HASH_ITER(hh, absorbed->frontier, entry, tmp) {
+        if (!tile_map_contains(keep->tiles, entry->cell))
+            pool_frontier_add(keep, entry->cell, entry->count);
+    }
+    int shared = 0;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(absorbed->tiles, tile, iter) {
+        shared += pool_count_member_neighbors(keep, tile, geometry_type);
+        pool_frontier_entry_t *covered = pool_frontier_find(keep, tile->cell);
+        if (covered)
+            pool_frontier_remove(keep, covered);
+    }
+    keep->neighbor_tiles_dirty = true;
+    keep->internal_edge_count += absorbed->internal_edge_count + shared;
+    keep->edge_count += absorbed->edge_count - 2 * shared;
+    for (int n = 0; n <= TILE_MAX_NEIGHBORS; n++)
+        keep->neighbor_histogram[n] += absorbed->neighbor_histogram[n];
+    for (int axis = 0; axis < 3; axis++)
+        keep->coord_sums[axis] += absorbed->coord_sums[axis];
+    keep->score_dirty = true;
+
+    // Absorbed's neighbors become keep's; pool_free unlinks absorbed later
+    pool_adjacency_entry_t *link, *next_link;
+    HASH_ITER(hh, absorbed->adjacent, link, next_link) {
+        pool_adjacency_add(keep, link->pool, link->shared_edges);
+    }
+
+    if (absorbed->extents.dirty) {
+        keep->extents.dirty = true;
+    } else if (!keep->extents.dirty) {
+        for (int axis = 0; axis < 3; axis++) {
+            if (absorbed->extents.min[axis] < keep->extents.min[axis])
+                keep->extents.min[axis] = absorbed->extents.min[axis];
+            if (absorbed->extents.max[axis] > keep->extents.max[axis])
+                keep->extents.max[axis] = absorbed->extents.max[axis];
+        }
+    }
+}
+
+void pool_track_neighbor_count_changed(pool_t *pool, int old_count,
+                                       int new_count) {
+    if (!pool || old_count == new_count)
+        return;
+    pool->neighbor_histogram[old_count]--;
+    pool->neighbor_histogram[new_count]++;
+}
+
+// Changes one side of a link; pool_adjacency_add keeps both sides in step
+static void pool_adjacency_bump(pool_t *pool, pool_t *other, int delta) {
+    pool_adjacency_entry_t *entry = NULL;
+    HASH_FIND_PTR(pool->adjacent, &other, entry);
+    if (!entry) {
+        if (delta <= 0)
+            return;
+        entry = malloc(sizeof(pool_adjacency_entry_t));
+        if (!entry) {
+            fprintf(stderr, "Out of memory!\n");
+            return;
+        }
+        entry->pool = other;
+        entry->shared_edges = 0;
+        HASH_ADD_PTR(pool->adjacent, pool, entry);
+    }
+    entry->shared_edges += delta;
+    if (entry->shared_edges <= 0) {
+        HASH_DEL(pool->adjacent, entry);
+        free(entry);
+    }
+}
+
+void pool_adjacency_add(pool_t *a, pool_t *b, int delta) {
+    if (!a || !b || a == b || delta == 0)
+        return;
+    pool_adjacency_bump(a, b, delta);
+    pool_adjacency_bump(b, a, delta);
+}
+
+int pool_adjacency_shared_edges(const pool_t *a, const pool_t *b) {
+    if (!a || !b)
+        return 0;
+    pool_adjacency_entry_t *entry = NULL;
+    HASH_FIND_PTR(a->adjacent, &b, entry);
+    return entry ? entry->shared_edges : 0;
+}
+
+void pool_adjacency_clear(pool_t *pool) {
+    if (!pool)
+        return;
+    pool_adjacency_entry_t *entry, *tmp;
+    HASH_ITER(hh, pool->adjacent, entry, tmp) {
+        pool_adjacency_entry_t *back = NULL;
+        HASH_FIND_PTR(entry->pool->adjacent, &pool, back);
+        if (back) {
+            HASH_DEL(entry->pool->adjacent, back);
+            free(back);
+        }
+        HASH_DEL(pool->adjacent, entry);
+        free(entry);
+    }
+}
+
+size_t pool_get_adjacent_pools(const pool_t *pool, tile_type_t type,
+                               pool_t **out_pools, size_t max_pools) {
+    if (!pool)
+        return 0;
+    size_t count = 0;
+    pool_adjacency_entry_t *entry, *tmp;
+    HASH_ITER(hh, pool->adjacent, entry, tmp) {
+        if (type != TILE_UNDEFINED && entry->pool->accepted_tile_type != type)
+            continue;
+        if (out_pools && count < max_pools)
+            out_pools[count] = entry->pool;
+        count++;
+    }
+    return count;
+}
+
+void pool_refresh_extents(pool_t *pool) {
+    if (!pool || !pool->extents.dirty)
+        return;
+    pool_extents_reset(&pool->extents);
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        pool_extents_include(&pool->extents, tile->cell);
+    }
+}
+
+bool pool_get_bounds(pool_t *pool, int out_min[3], int out_max[3]) {
+    if (!pool || !pool->tiles || pool->tiles->num_tiles == 0)
+        return false;
+    pool_refresh_extents(pool);
+    for (int axis = 0; axis < 3; axis++) {
+        out_min[axis] = pool->extents.min[axis];
+        out_max[axis] = pool->extents.max[axis];
+    }
+    return true;
+}
+
+bool pool_verify_edge_counts(const pool_t *pool, grid_type_e geometry_type) {
+    if (!pool || !pool->tiles)
+        return false;
+
+    int external = pool_calculate_edge_count(pool, geometry_type);
+    int internal = 0;
+    size_t count = pool->tiles->num_tiles;
+    grid_cell_t *cells = count ? malloc(count * sizeof(grid_cell_t)) : NULL;
+    if (cells) {
+        tile_map_iter_t iter;
+        tile_t *tile;
+        size_t i = 0;
+        TILE_MAP_ITER(pool->tiles, tile, iter) {
+            cells[i++] = tile->cell;
+        }
+        internal =
+          grid_geometry_count_internal_edges(geometry_type, cells, count);
+        free(cells);
+    }
+
+    int histogram[TILE_MAX_NEIGHBORS + 1] = {0};
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        histogram[tile_same_type_neighbor_count(tile)]++;
+    }
+    if (memcmp(histogram, pool->neighbor_histogram, sizeof(histogram)) != 0) {
+        fprintf(stderr, "Pool %d neighbor histogram out of sync\n", pool->id);
+        return false;
+    }
+
+    int64_t sums[3] = {0, 0, 0};
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        sums[0] += tile->cell.coord.hex.q;
+        sums[1] += tile->cell.coord.hex.r;
+        sums[2] += tile->cell.coord.hex.s;
+    }
+    if (memcmp(sums, pool->coord_sums, sizeof(sums)) != 0) {
+        fprintf(stderr, "Pool %d coordinate sums out of sync\n", pool->id);
+        return false;
+    }
+
+    if (external != pool->edge_count ||
+        internal != pool->internal_edge_count) {
+        fprintf(stderr,
+                "Pool %d edge counters out of sync: external %d (expected "
+                "%d), internal %d (expected %d)\n",
+                pool->id, pool->edge_count, external,
+                pool->internal_edge_count, internal);
+        return false;
+    }
+    return true;
 }
 
 int pool_calculate_diameter(const pool_t *pool, grid_type_e geometry_type) {
@@ -97,15 +515,31 @@ int pool_calculate_diameter(const pool_t *pool, grid_type_e geometry_type) {
         return 0;
     }
 
+    if (geometry_type == GRID_TYPE_HEXAGON) {
+        if (!pool->extents.dirty)
+            return pool_extents_span(&pool->extents);
+
+        // One pass over the tiles; the pool's own extents stay dirty
+        pool_extents_t extents;
+        pool_extents_reset(&extents);
+        tile_map_iter_t iter;
+        tile_t *tile;
+        TILE_MAP_ITER(pool->tiles, tile, iter) {
+            pool_extents_include(&extents, tile->cell);
+        }
+        return pool_extents_span(&extents);
+    }
+
     // Extract cells from pool tiles
     grid_cell_t *cells = malloc(pool->tiles->num_tiles * sizeof(grid_cell_t));
     if (!cells)
         return 0;
 
-    tile_map_entry_t *entry, *tmp;
+    tile_map_iter_t iter;
+    tile_t *tile;
     size_t i = 0;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        cells[i] = entry->tile->cell;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        cells[i] = tile->cell;
         i++;
     }
 
@@ -123,15 +557,20 @@ grid_cell_t pool_calculate_center(const pool_t *pool,
         return invalid_cell;
     }
 
+    if (geometry_type == GRID_TYPE_HEXAGON)
+        return grid_geometry_center_from_sums(geometry_type, pool->coord_sums,
+                                              pool->tiles->num_tiles);
+
     // Extract cells from pool tiles
     grid_cell_t *cells = malloc(pool->tiles->num_tiles * sizeof(grid_cell_t));
     if (!cells)
         return invalid_cell;
 
-    tile_map_entry_t *entry, *tmp;
+    tile_map_iter_t iter;
+    tile_t *tile;
     size_t i = 0;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        cells[i] = entry->tile->cell;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        cells[i] = tile->cell;
         i++;
     }
 
@@ -152,10 +591,11 @@ int pool_calculate_edge_count(const pool_t *pool, grid_type_e geometry_type) {
     if (!cells)
         return 0;
 
-    tile_map_entry_t *entry, *tmp;
+    tile_map_iter_t iter;
+    tile_t *tile;
     size_t i = 0;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        cells[i] = entry->tile->cell;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        cells[i] = tile->cell;
         i++;
     }
 
@@ -171,32 +611,9 @@ float pool_calculate_compactness_score(const pool_t *pool) {
         return 0.0f;
     }
 
-    // Get actual tile count
-    int actual_tiles = pool->tiles->num_tiles;
-
-    // Extract coordinates from tile map hash table
-    grid_cell_t *coordinates = malloc(actual_tiles * sizeof(grid_cell_t));
-    if (!coordinates) {
-        return 0.0f;
-    }
-
-    int index = 0;
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        coordinates[index++] = entry->cell;
-    }
-
-    // Calculate internal edges (shared between tiles in pool)
-    int internal_edges = grid_geometry_count_internal_edges(
-      GRID_TYPE_HEXAGON, coordinates, actual_tiles);
-
-    free(coordinates);
-
-    // External edges are already calculated and stored in pool
-    int external_edges = pool->edge_count;
-
     // Total edges = internal + external
-    int total_edges = internal_edges + external_edges;
+    int internal_edges = pool->internal_edge_count;
+    int total_edges = internal_edges + pool->edge_count;
 
     if (total_edges == 0) {
         return 0.0f;
@@ -226,7 +643,7 @@ void pool_print(const pool_t *pool) {
         printf("Diameter: %d\n", pool->diameter);
         printf("Edge count: %d\n", pool->edge_count);
         printf("Compactness score: %.3f\n", pool->compactness_score);
-        printf("Neighbor cell count: %zu\n", pool->neighbor_cells.n);
+        printf("Neighbor cell count: %u\n", HASH_COUNT(pool->frontier));
         printf("Neighbor tile count: %zu\n", pool->neighbor_tiles.n);
         printf("========================\n");
     }
@@ -241,7 +658,8 @@ bool pool_accepts_tile_type(const pool_t *pool, tile_type_t type) {
     // Check if the tile's type matches the pool's accepted type.
     return pool->accepted_tile_type == type;
 }
-void pool_remove_tile(const pool_t *pool, const tile_t *tile_ptr) {
+void pool_remove_tile(pool_t *pool, const tile_t *tile_ptr,
+                      grid_type_e geometry_type) {
     if (!pool || !tile_ptr)
         return;
 
@@ -252,78 +670,56 @@ void pool_remove_tile(const pool_t *pool, const tile_t *tile_ptr) {
 
     // Remove the tile from the pool's internal tile map
     tile_map_remove(pool->tiles, tile_ptr->cell);
+    pool_track_tile_removed(pool, tile_ptr, geometry_type);
 }
 
-static bool is_cell_in_neighbor_list(const pool_t *pool, grid_cell_t cell,
-                                     grid_type_e geometry_type) {
-    for (size_t i = 0; i < kv_size(pool->neighbor_cells); i++) {
-        if (grid_geometry_cells_equal(geometry_type,
-                                      kv_A(pool->neighbor_cells, i), cell)) {
-            return true;
-        }
-    }
-    return false;
+void pool_invalidate_neighbor_tiles(pool_t *pool) {
+    if (pool)
+        pool->neighbor_tiles_dirty = true;
 }
 
-void pool_update_neighbors(pool_t *pool, const tile_map_t *board_tiles,
-                           grid_type_e geometry_type) {
-    if (!pool || !board_tiles)
-        return;
-
-    // --- 1. Update neighbor cells ---
-    kv_destroy(pool->neighbor_cells);
-    kv_init(pool->neighbor_cells);
-
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        int num_neighbors = grid_geometry_get_neighbor_count(geometry_type);
-        grid_cell_t neighbors[num_neighbors];
-        grid_geometry_get_all_neighbors(geometry_type, entry->tile->cell,
-                                        neighbors);
-
-        for (int i = 0; i < num_neighbors; i++) {
-            grid_cell_t n = neighbors[i];
-
-            // Skip if already in pool or already added to neighbor_cells
-            if (tile_map_contains(pool->tiles, n))
-                continue;
-
-            bool duplicate = false;
-            for (size_t j = 0; j < kv_size(pool->neighbor_cells); j++) {
-                if (grid_geometry_cells_equal(
-                      geometry_type, kv_A(pool->neighbor_cells, j), n)) {
-                    duplicate = true;
-                    break;
-                }
-            }
+tile_t **pool_get_neighbor_tiles(pool_t *pool, const tile_map_t *board_tiles,
+                                 size_t *out_count) {
+    if (!pool) {
+        if (out_count)
+            *out_count = 0;
+        return NULL;
+    }
 
-            if (!duplicate) {
-                kv_push(grid_cell_t, pool->neighbor_cells, n);
+    if (pool->neighbor_tiles_dirty && board_tiles) {
+        kv_size(pool->neighbor_tiles) = 0;
+        pool_frontier_entry_t *entry, *tmp;
+        HASH_ITER(hh, pool->frontier, entry, tmp) {
+            tile_t *neighbor_tile = tile_map_get(board_tiles, entry->cell);
+            if (neighbor_tile) {
+                kv_push(tile_t *, pool->neighbor_tiles, neighbor_tile);
             }
         }
+        pool->neighbor_tiles_dirty = false;
     }
 
-    // --- 2. Update neighbor tiles ---
-    kv_destroy(pool->neighbor_tiles);
-    kv_init(pool->neighbor_tiles);
-
-    for (size_t i = 0; i < kv_size(pool->neighbor_cells); i++) {
-        grid_cell_t cell = kv_A(pool->neighbor_cells, i);
+    if (out_count)
+        *out_count = kv_size(pool->neighbor_tiles);
+    return pool->neighbor_tiles.a;
+}
 
-        tile_map_entry_t *neighbor_entry = tile_map_find(board_tiles, cell);
-        if (neighbor_entry) {
-            kv_push(tile_t *, pool->neighbor_tiles, neighbor_entry->tile);
-        }
+int pool_get_neighbor_cells(const pool_t *pool, grid_cell_t *out_cells) {
+    if (!pool)
+        return 0;
+    int count = 0;
+    pool_frontier_entry_t *entry, *tmp;
+    HASH_ITER(hh, pool->frontier, entry, tmp) {
+        if (out_cells)
+            out_cells[count] = entry->cell;
+        count++;
     }
-
-    printf("Pool %d: %zu neighbor cells, %zu neighbor tiles\n", pool->id,
-           kv_size(pool->neighbor_cells), kv_size(pool->neighbor_tiles));
+    return count;
 }
 
 // Main function: Adds a tile to a pool if it passes validations.
 bool pool_add_tile(pool_t *pool, const tile_t *tile, grid_type_e geometry_type,
                    const tile_map_t *board_tiles) {
-
+    (void)board_tiles;
     if (!pool || !tile)
         return false;
 
@@ -337,23 +733,48 @@ bool pool_add_tile(pool_t *pool, const tile_t *tile, grid_type_e geometry_type,
 
     // Add the tile to the pool's internal tile map.
     tile_map_add(pool->tiles, (tile_t *)tile);
+    pool_track_tile_added(pool, tile, geometry_type);
 
     if (pool->accepted_tile_type == TILE_UNDEFINED) {
         // If the pool has no accepted tile type, set it to the tile's type.
         pool->accepted_tile_type = tile->data.type;
     }
 
-    // Update geometric properties after adding tile
+    // Update geometric properties after adding tile; the frontier was
+    // updated by pool_track_tile_added
     pool_update_geometric_properties(pool, geometry_type);
-
-    // Update neighbors after adding tile
-    pool_update_neighbors(pool, board_tiles, geometry_type);
     return true;
 }
 
+size_t pool_add_tiles(pool_t *pool, tile_t *const *tiles, size_t count,
+                      grid_type_e geometry_type, const tile_map_t *board_tiles) {
+    (void)board_tiles;
+    if (!pool || !tiles)
+        return 0;
+
+    size_t added = 0;
+    for (size_t i = 0; i < count; i++) {
+        tile_t *tile = tiles[i];
+        if (!tile || pool_contains_tile(pool, tile) ||
+            !pool_accepts_tile_type(pool, tile->data.type))
+            continue;
+        if (pool->accepted_tile_type == TILE_UNDEFINED)
+            pool->accepted_tile_type = tile->data.type;
+        tile_map_add(pool->tiles, tile);
+        pool_track_tile_added(pool, tile, geometry_type);
+        added++;
+    }
+
+    if (added > 0)
+        pool_update_geometric_properties(pool, geometry_type);
+    return added;
+}
+
 void pool_free(pool_t *pool) {
+    pool_adjacency_clear(pool);
     tile_map_free(pool->tiles);
-    kv_destroy(pool->neighbor_cells);
+    HASH_CLEAR(hh, pool->frontier);
+    slab_destroy(pool->frontier_slab);
     kv_destroy(pool->neighbor_tiles);
     free(pool);
 };
@@ -377,7 +798,7 @@ int pool_find_tile_friendly_neighbor_count(tile_map_t *tile_map,
                                            grid_type_e grid_type) {
     int num_neighbors = grid_geometry_get_neighbor_count(grid_type);
     grid_cell_t neighbor_cells[num_neighbors];
-    grid_geometry_get_all_neighbors(grid_type, tile->cell, neighbor_cells);
+    hex_kernel_grid_neighbors(grid_type, tile->cell, neighbor_cells);
 
     int neighbor_count = 0;
     for (int i = 0; i < num_neighbors; ++i) {
@@ -390,23 +811,12 @@ int pool_find_tile_friendly_neighbor_count(tile_map_t *tile_map,
 }
 
 int pool_find_max_tile_neighbors_in_pool(pool_t *pool, grid_type_e grid_type) {
-
-    if (!pool->tiles) {
-        printf("Pool tiles not found\n");
-        return 0;
+    (void)grid_type;
+    for (int n = TILE_MAX_NEIGHBORS; n > 0; n--) {
+        if (pool->neighbor_histogram[n] > 0)
+            return n;
     }
-
-    int best_score = 0;
-    tile_map_entry_t *entry, *tmp;
-    HASH_ITER(hh, pool->tiles->root, entry, tmp) {
-        int score = pool_find_tile_friendly_neighbor_count(
-          pool->tiles, entry->tile, grid_type);
-        if (score > best_score) {
-            best_score = score;
-        }
-    }
-
-    return best_score;
+    return 0;
 }
 
 void pool_calculate_score(pool_t *pool, grid_type_e grid_type) {
@@ -432,3 +842,13 @@ int pool_tile_score(const pool_t *pool) {
     // return total_value;
     return pool->tiles->num_tiles;
 }
+
+float pool_get_score(pool_t *pool) {
+    if (!pool)
+        return 0.0f;
+    if (pool->score_dirty) {
+        pool->score = (float)pool_tile_score(pool) * pool->modifier;
+        pool->score_dirty = false;
+    }
+    return pool->score;
+}
@@ -1,6 +1,93 @@
 #include "../../include/tile/pool_manager.h"
+#include "../../include/grid/grid_geometry.h"
+#include "../../include/grid/hex_kernels.h"
+#include "../../include/utility/slab.h"
+#include "third_party/kvec.h"
 #include <stdio.h>
 
+// Records which split search reached a tile first
+typedef struct pool_split_mark {
+    tile_t *tile; // Key
+    int search;
+    UT_hash_handle hh;
+} pool_split_mark_t;
+
+#define POOL_SPLIT_MARK_CHUNK 256
+
+// --- Leaderboard heap ---
+
+// True if 'a' ranks above 'b': higher score, then lower id. Compares the
+// cached scores, so a pool whose score is dirty keeps its old key until
+// pool_manager_update_score refreshes it and moves it in one step.
+static bool pool_leaderboard_before(const pool_t *a, const pool_t *b) {
+    if (a->score != b->score)
+        return a->score > b->score;
+    return a->id < b->id;
+}
+
+static void pool_leaderboard_place(pool_manager_t *map, size_t index,
+                                   pool_t *pool) {
+    kv_A(map->leaderboard, index) = pool;
+    pool->leaderboard_index = index;
+}
+
+static void pool_leaderboard_sift_up(pool_manager_t *map, size_t index) {
+    pool_t *pool = kv_A(map->leaderboard, index);
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        pool_t *above = kv_A(map->leaderboard, parent);
+        if (!pool_leaderboard_before(pool, above))
+            break;
+        pool_leaderboard_place(map, index, above);
+        index = parent;
+    }
+    pool_leaderboard_place(map, index, pool);
+}
+
+static void pool_leaderboard_sift_down(pool_manager_t *map, size_t index) {
+    size_t size = kv_size(map->leaderboard);
+    pool_t *pool = kv_A(map->leaderboard, index);
+    for (;;) {
+        size_t child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size &&
+            pool_leaderboard_before(kv_A(map->leaderboard, child + 1),
+                                    kv_A(map->leaderboard, child)))
+            child++;
+        if (!pool_leaderboard_before(kv_A(map->leaderboard, child), pool))
+            break;
+        pool_leaderboard_place(map, index, kv_A(map->leaderboard, child));
+        index = child;
+    }
+    pool_leaderboard_place(map, index, pool);
+}
+
+static bool pool_leaderboard_contains(const pool_manager_t *map,
+                                      const pool_t *pool) {
+    return pool->leaderboard_index < kv_size(map->leaderboard) &&
+           kv_A(map->leaderboard, pool->leaderboard_index) == pool;
+}
+
+static void pool_leaderboard_insert(pool_manager_t *map, pool_t *pool) {
+    pool_get_score(pool);
+    kv_push(pool_t *, map->leaderboard, pool);
+    pool_leaderboard_sift_up(map, kv_size(map->leaderboard) - 1);
+}
+
+static void pool_leaderboard_remove(pool_manager_t *map, pool_t *pool) {
+    if (!pool_leaderboard_contains(map, pool))
+        return;
+    size_t index = pool->leaderboard_index;
+    pool_t *last = kv_pop(map->leaderboard);
+    if (last == pool)
+        return;
+    // The last pool fills the hole and moves whichever way it belongs
+    pool_leaderboard_place(map, index, last);
+    pool_leaderboard_sift_up(map, index);
+    pool_leaderboard_sift_down(map, last->leaderboard_index);
+}
+
 pool_manager_t *pool_manager_create(void) {
     pool_manager_t *map = malloc(sizeof(pool_manager_t));
     if (!map) {
@@ -10,6 +97,15 @@ pool_manager_t *pool_manager_create(void) {
     map->root = NULL;
     map->num_pools = 0;
     map->next_id = 1; // Start from 1 since 0 means "no pool"
+    kv_init(map->leaderboard);
+
+    // Label 0 stands for "no pool" and is never joined with anything
+    map->labels = disjoint_set_create();
+    if (!map->labels || !disjoint_set_make(map->labels, NULL)) {
+        disjoint_set_free(map->labels);
+        free(map);
+        return NULL;
+    }
     return map;
 }
 
@@ -19,10 +115,13 @@ void pool_manager_free(pool_manager_t *map) {
     pool_manager_entry_t *el, *tmp;
     HASH_ITER(hh, map->root, el, tmp) {
         HASH_DEL(map->root, el);
+        pool_free(el->pool); // Adjacency is cleared on both sides
         free(el);
     }
     map->num_pools = 0;
     map->next_id = 1; // Reset to 1 since 0 means "no pool"
+    kv_destroy(map->leaderboard);
+    disjoint_set_free(map->labels);
     free(map);
 }
 
@@ -50,13 +149,18 @@ void pool_manager_add(pool_manager_t *map, pool_t *pool) {
     pool_manager_entry_t *existing = pool_manager_find_by_id(map, pool->id);
     if (existing) {
         fprintf(stderr, "ERROR: Duplicate pool ID %d\n", pool->id);
+        pool_leaderboard_remove(map, existing->pool);
         HASH_DEL(map->root, existing);
         free(existing);
         map->num_pools--;
     }
 
-    // Assign a new unique ID to the pool.
-    pool->id = map->next_id++;
+    // Assign a new unique ID to the pool; ids are union-find labels
+    uint32_t label;
+    if (!disjoint_set_make(map->labels, &label))
+        return;
+    pool->id = (int)label;
+    map->next_id = pool->id + 1;
 
     pool_manager_entry_t *entry = malloc(sizeof(pool_manager_entry_t));
     if (!entry) {
@@ -68,16 +172,31 @@ void pool_manager_add(pool_manager_t *map, pool_t *pool) {
     entry->pool = pool;
     HASH_ADD_INT(map->root, id, entry);
     map->num_pools++;
+    pool_leaderboard_insert(map, pool);
 }
 
 pool_manager_entry_t *pool_manager_find_by_tile(pool_manager_t *map,
                                                 tile_t *tile) {
-    pool_manager_entry_t *entry = NULL;
-    for (entry = map->root; entry != NULL; entry = entry->hh.next) {
-        if (pool_contains_tile(entry->pool, tile))
-            return entry;
-    }
-    return NULL;
+    if (!map || !tile)
+        return NULL;
+    uint32_t pool_id = pool_manager_tile_pool_id(map, tile);
+    if (pool_id == 0)
+        return NULL;
+    pool_manager_entry_t *entry = pool_manager_find_by_id(map, (int)pool_id);
+    return entry && pool_contains_tile(entry->pool, tile) ? entry : NULL;
+}
+
+uint32_t pool_manager_resolve_id(pool_manager_t *map, uint32_t pool_id) {
+    if (!map || pool_id == 0)
+        return 0;
+    return disjoint_set_find(map->labels, pool_id);
+}
+
+uint32_t pool_manager_tile_pool_id(pool_manager_t *map, tile_t *tile) {
+    if (!tile)
+        return 0;
+    tile->pool_id = pool_manager_resolve_id(map, tile->pool_id);
+    return tile->pool_id;
 }
 
 bool pool_manager_contains_tile(pool_manager_t *map, tile_t *tile) {
@@ -90,9 +209,9 @@ bool pool_manager_contains_tile(pool_manager_t *map, tile_t *tile) {
 void pool_manager_remove(pool_manager_t *map, int id) {
     if (!map)
         return;
-    pool_manager_entry_t *entry_to_remove = NULL;
-    HASH_FIND_INT(map->root, &id, entry_to_remove);
+    pool_manager_entry_t *entry_to_remove = pool_manager_find_by_id(map, id);
     if (entry_to_remove) {
+        pool_leaderboard_remove(map, entry_to_remove->pool);
         HASH_DEL(map->root, entry_to_remove);
         free(entry_to_remove);
         map->num_pools--;
@@ -101,8 +220,11 @@ void pool_manager_remove(pool_manager_t *map, int id) {
 
 pool_manager_entry_t *pool_manager_find_by_id(pool_manager_t *map,
                                               int pool_id) {
+    if (!map || pool_id <= 0)
+        return NULL;
+    int live_id = (int)pool_manager_resolve_id(map, (uint32_t)pool_id);
     pool_manager_entry_t *entry = NULL;
-    HASH_FIND_INT(map->root, &pool_id, entry);
+    HASH_FIND_INT(map->root, &live_id, entry);
     return entry;
 }
 
@@ -119,33 +241,229 @@ pool_t *pool_manager_get_pool_by_tile(pool_manager_t *map, tile_t *tile) {
 
 // --- New Pool Management Functions ---
 
-void pool_manager_merge_pools(pool_manager_t *manager, int target_id,
-                              int source_id, grid_type_e geometry_type,
-                              tile_map_t *board_tiles) {
-    if (!manager || target_id == source_id)
-        return;
+pool_t *pool_manager_merge_pools(pool_manager_t *manager, int target_id,
+                                 int source_id, grid_type_e geometry_type,
+                                 tile_map_t *board_tiles) {
+    (void)board_tiles;
+    if (!manager)
+        return NULL;
 
-    pool_t *target_pool = pool_manager_get_pool(manager, target_id);
-    pool_t *source_pool = pool_manager_get_pool(manager, source_id);
+    pool_manager_entry_t *target_entry =
+      pool_manager_find_by_id(manager, target_id);
+    pool_manager_entry_t *source_entry =
+      pool_manager_find_by_id(manager, source_id);
+    if (!target_entry || !source_entry)
+        return NULL;
+    if (target_entry == source_entry)
+        return target_entry->pool;
+
+    // Splice the smaller pool into the larger one, so a tile is moved at most
+    // O(log n) times over any sequence of merges
+    pool_manager_entry_t *keep_entry = target_entry;
+    pool_manager_entry_t *absorbed_entry = source_entry;
+    if (keep_entry->pool->tiles->num_tiles <
+        absorbed_entry->pool->tiles->num_tiles) {
+        keep_entry = source_entry;
+        absorbed_entry = target_entry;
+    }
+    pool_t *keep = keep_entry->pool;
+    pool_t *absorbed = absorbed_entry->pool;
+
+    pool_track_merge(keep, absorbed, geometry_type);
+    tile_map_iter_t iter;
+    tile_t *tile_to_move;
+    TILE_MAP_ITER(absorbed->tiles, tile_to_move, iter) {
+        tile_map_add_unchecked(keep->tiles, tile_to_move);
+    }
 
-    if (!target_pool || !source_pool)
-        return;
+    // Join the labels; the survivor takes the union-find root as its id so
+    // every old tile pool_id resolves to it without being rewritten
+    uint32_t root = disjoint_set_union(manager->labels, (uint32_t)keep->id,
+                                       (uint32_t)absorbed->id);
+    pool_leaderboard_remove(manager, absorbed);
+    HASH_DEL(manager->root, absorbed_entry);
+    free(absorbed_entry);
+    manager->num_pools--;
+    pool_free(absorbed);
+    if (keep->id != (int)root) {
+        HASH_DEL(manager->root, keep_entry);
+        keep->id = (int)root;
+        keep_entry->id = keep->id;
+        HASH_ADD_INT(manager->root, id, keep_entry);
+    }
+
+    // Refresh derived state once for the whole merge
+    pool_update_geometric_properties(keep, geometry_type);
+    pool_manager_update_score(manager, keep);
+    return keep;
+}
+
+static int pool_split_find(int *parent, int search) {
+    while (parent[search] != search)
+        search = parent[search] = parent[parent[search]];
+    return search;
+}
+
+static bool pool_split_mark(slab_t *mark_slab, pool_split_mark_t **marks,
+                            tile_t *tile, int search) {
+    pool_split_mark_t *mark = slab_alloc(mark_slab);
+    if (!mark)
+        return false;
+    mark->tile = tile;
+    mark->search = search;
+    HASH_ADD_PTR(*marks, tile, mark);
+    return true;
+}
+
+// Moves the tiles marked by searches rooted at 'root' out of 'pool', into a
+// new pool or back to singletons. Returns true if a pool was created.
+static bool pool_split_detach(pool_manager_t *manager, pool_t *pool,
+                              pool_split_mark_t *marks, int *parent, int root,
+                              size_t component_size,
+                              grid_type_e geometry_type,
+                              const tile_map_t *board_tiles) {
+    pool_t *new_pool = NULL;
+    if (component_size >= 2) {
+        new_pool = pool_manager_create_pool(manager);
+        if (!new_pool)
+            return false;
+        new_pool->accepted_tile_type = pool->accepted_tile_type;
+    }
+
+    pool_split_mark_t *mark, *tmp;
+    HASH_ITER(hh, marks, mark, tmp) {
+        if (pool_split_find(parent, mark->search) != root)
+            continue;
+        tile_map_remove(pool->tiles, mark->tile->cell);
+        pool_track_tile_removed(pool, mark->tile, geometry_type);
+        if (new_pool) {
+            tile_map_add(new_pool->tiles, mark->tile);
+            pool_track_tile_added(new_pool, mark->tile, geometry_type);
+            mark->tile->pool_id = new_pool->id;
+        } else {
+            mark->tile->pool_id = 0;
+        }
+        pool_manager_track_tile_moved(manager, mark->tile, pool, new_pool,
+                                      geometry_type, board_tiles);
+    }
+
+    if (new_pool) {
+        pool_update_geometric_properties(new_pool, geometry_type);
+        pool_manager_update_score(manager, new_pool);
+    }
+    return new_pool != NULL;
+}
+
+size_t pool_manager_split_pool(pool_manager_t *manager, pool_t *pool,
+                               grid_cell_t removed_cell,
+                               grid_type_e geometry_type,
+                               const tile_map_t *board_tiles) {
+    if (!manager || !pool)
+        return 0;
+
+    // Every fragment touches the removed cell, so one search starts at each
+    // of its neighbors that is still in the pool
+    int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbor_cells[neighbor_count];
+    hex_kernel_grid_neighbors(geometry_type, removed_cell, neighbor_cells);
+    tile_t *starts[neighbor_count];
+    int search_count = 0;
+    for (int i = 0; i < neighbor_count; i++) {
+        tile_t *start = tile_map_get(pool->tiles, neighbor_cells[i]);
+        if (start)
+            starts[search_count++] = start;
+    }
 
-    // Move all tiles from source to target
-    tile_map_entry_t *tile_entry, *tmp;
-    HASH_ITER(hh, source_pool->tiles->root, tile_entry, tmp) {
-        tile_t *tile_to_move = tile_entry->tile;
-        tile_to_move->pool_id = target_id;
+    size_t pools_created = 0;
+    if (search_count >= 2) {
+        slab_t *mark_slab =
+          slab_create(sizeof(pool_split_mark_t), POOL_SPLIT_MARK_CHUNK);
+        pool_split_mark_t *marks = NULL;
+        kvec_t(tile_t *) queues[search_count];
+        size_t heads[search_count];
+        size_t visited[search_count]; // Tiles reached, kept on group roots
+        int parent[search_count];
+        bool detached[search_count];
+        bool ok = mark_slab != NULL;
+
+        for (int s = 0; s < search_count; s++) {
+            kv_init(queues[s]);
+            kv_push(tile_t *, queues[s], starts[s]);
+            heads[s] = 0;
+            visited[s] = 1;
+            parent[s] = s;
+            detached[s] = false;
+            ok = ok && pool_split_mark(mark_slab, &marks, starts[s], s);
+        }
 
-        // Remove from source pool's tile map
-        tile_map_remove(source_pool->tiles, tile_to_move->cell);
+        // Advance the searches in lockstep, one tile each per round. Searches
+        // that meet are joined; a group whose queues all run dry has found a
+        // whole fragment. The last group left stays in 'pool', so the work
+        // done is bounded by the size of the smaller fragments.
+        int live = search_count;
+        while (ok && live > 1) {
+            for (int s = 0; s < search_count && ok; s++) {
+                if (heads[s] == kv_size(queues[s]))
+                    continue;
+                tile_t *tile = kv_A(queues[s], heads[s]++);
+                grid_cell_t cells[neighbor_count];
+                hex_kernel_grid_neighbors(geometry_type, tile->cell, cells);
+                for (int i = 0; i < neighbor_count; i++) {
+                    tile_t *next = tile_map_get(pool->tiles, cells[i]);
+                    if (!next)
+                        continue;
+                    pool_split_mark_t *mark = NULL;
+                    HASH_FIND_PTR(marks, &next, mark);
+                    if (!mark) {
+                        ok = pool_split_mark(mark_slab, &marks, next, s);
+                        kv_push(tile_t *, queues[s], next);
+                        visited[pool_split_find(parent, s)]++;
+                        continue;
+                    }
+                    int a = pool_split_find(parent, s);
+                    int b = pool_split_find(parent, mark->search);
+                    if (a != b) {
+                        parent[b] = a;
+                        visited[a] += visited[b];
+                        live--;
+                    }
+                }
+            }
+
+            for (int root = 0; root < search_count && ok && live > 1; root++) {
+                if (parent[root] != root || detached[root])
+                    continue;
+                bool exhausted = true;
+                for (int s = 0; s < search_count; s++) {
+                    if (pool_split_find(parent, s) == root &&
+                        heads[s] != kv_size(queues[s])) {
+                        exhausted = false;
+                        break;
+                    }
+                }
+                if (!exhausted)
+                    continue;
+                pools_created +=
+                  pool_split_detach(manager, pool, marks, parent, root,
+                                    visited[root], geometry_type, board_tiles);
+                detached[root] = true;
+                live--;
+            }
+        }
 
-        // Add to target pool
-        pool_add_tile(target_pool, tile_to_move, geometry_type, board_tiles);
+        if (!ok)
+            fprintf(stderr, "Out of memory!\n");
+        for (int s = 0; s < search_count; s++) {
+            kv_destroy(queues[s]);
+        }
+        HASH_CLEAR(hh, marks);
+        slab_destroy(mark_slab);
     }
 
-    // Remove the source pool
-    pool_manager_remove(manager, source_id);
+    if (pool->tiles->num_tiles >= 2)
+        pool_update_geometric_properties(pool, geometry_type);
+    pool_manager_update_score(manager, pool);
+    return pools_created;
 }
 
 void pool_manager_find_compatible_pools(pool_manager_t *manager, tile_t *tile,
@@ -167,20 +485,21 @@ void pool_manager_find_compatible_pools(pool_manager_t *manager, tile_t *tile,
             continue;
 
         // Skip singletons (pool_id == 0)
-        if (neighbor_tiles[i]->pool_id == 0)
+        uint32_t pool_id = pool_manager_tile_pool_id(manager, neighbor_tiles[i]);
+        if (pool_id == 0)
             continue;
 
         // Check if we already have this pool ID
         bool already_added = false;
         for (size_t j = 0; j < *out_count; j++) {
-            if (out_pool_ids[j] == neighbor_tiles[i]->pool_id) {
+            if (out_pool_ids[j] == pool_id) {
                 already_added = true;
                 break;
             }
         }
 
         if (!already_added) {
-            out_pool_ids[(*out_count)++] = neighbor_tiles[i]->pool_id;
+            out_pool_ids[(*out_count)++] = pool_id;
         }
     }
 }
@@ -194,18 +513,16 @@ pool_t *pool_manager_assign_tile(pool_manager_t *manager, tile_t *tile,
     // Get neighbors
     int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
     grid_cell_t neighbor_cells[neighbor_count];
-    grid_geometry_get_all_neighbors(geometry_type, tile->cell, neighbor_cells);
+    hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbor_cells);
 
-    // Convert to tile pointers
+    // Only same-type neighbors matter, and the tile's mask already says
+    // which directions hold one
     tile_t *neighbor_tiles[neighbor_count];
-    bool has_same_type_neighbors = false;
+    bool has_same_type_neighbors = tile->same_type_mask != 0;
     for (int i = 0; i < neighbor_count; i++) {
-        tile_map_entry_t *entry = tile_map_find(board_tiles, neighbor_cells[i]);
-        neighbor_tiles[i] = entry ? entry->tile : NULL;
-        if (neighbor_tiles[i] &&
-            neighbor_tiles[i]->data.type == tile->data.type) {
-            has_same_type_neighbors = true;
-        }
+        neighbor_tiles[i] = tile->same_type_mask & (1u << i)
+                              ? tile_map_get(board_tiles, neighbor_cells[i])
+                              : NULL;
     }
 
 // Find compatible pools
@@ -233,6 +550,9 @@ pool_t *pool_manager_assign_tile(pool_manager_t *manager, tile_t *tile,
                     neighbor_tiles[i]->pool_id = target_pool->id;
                     pool_add_tile(target_pool, neighbor_tiles[i], geometry_type,
                                   board_tiles);
+                    pool_manager_track_tile_moved(manager, neighbor_tiles[i],
+                                                  NULL, target_pool,
+                                                  geometry_type, board_tiles);
                 }
             }
         } else {
@@ -245,20 +565,23 @@ pool_t *pool_manager_assign_tile(pool_manager_t *manager, tile_t *tile,
         target_pool = pool_manager_get_pool(manager, compatible_pool_ids[0]);
         tile->pool_id = target_pool->id;
     } else {
-        // Multiple pools - use first as target and merge others into it
+        // Multiple pools - merge them all; the largest one survives
         target_pool = pool_manager_get_pool(manager, compatible_pool_ids[0]);
-        tile->pool_id = target_pool->id;
-
-        for (size_t i = 1; i < num_compatible_pools; i++) {
-            pool_manager_merge_pools(manager, compatible_pool_ids[0],
-                                     compatible_pool_ids[i], geometry_type,
-                                     board_tiles);
+        for (size_t i = 1; i < num_compatible_pools && target_pool; i++) {
+            target_pool = pool_manager_merge_pools(
+              manager, target_pool->id, compatible_pool_ids[i], geometry_type,
+              board_tiles);
         }
+        if (!target_pool)
+            return NULL;
+        tile->pool_id = target_pool->id;
     }
 
     // Add tile to the pool
     if (target_pool) {
         pool_add_tile(target_pool, tile, geometry_type, board_tiles);
+        pool_manager_track_tile_moved(manager, tile, NULL, target_pool,
+                                      geometry_type, board_tiles);
 
         // Add any remaining singleton neighbors
         for (int i = 0; i < neighbor_count; i++) {
@@ -268,13 +591,56 @@ pool_t *pool_manager_assign_tile(pool_manager_t *manager, tile_t *tile,
                 neighbor_tiles[i]->pool_id = target_pool->id;
                 pool_add_tile(target_pool, neighbor_tiles[i], geometry_type,
                               board_tiles);
+                pool_manager_track_tile_moved(manager, neighbor_tiles[i], NULL,
+                                              target_pool, geometry_type,
+                                              board_tiles);
             }
         }
+        pool_manager_update_score(manager, target_pool);
     }
 
     return target_pool;
 }
 
+pool_t *pool_manager_assign_group(pool_manager_t *manager, tile_t **tiles,
+                                  size_t count, const uint32_t *pool_ids,
+                                  size_t pool_count, grid_type_e geometry_type,
+                                  tile_map_t *board_tiles) {
+    if (!manager || !tiles || count == 0 || !board_tiles)
+        return NULL;
+
+    pool_t *target_pool = NULL;
+    if (pool_count == 0) {
+        if (count < 2)
+            return NULL;
+        target_pool = pool_manager_create_pool(manager);
+        if (!target_pool)
+            return NULL;
+        target_pool->accepted_tile_type = tiles[0]->data.type;
+    } else {
+        // Merge every touching pool; the largest one survives
+        target_pool = pool_manager_get_pool(manager, (int)pool_ids[0]);
+        for (size_t i = 1; i < pool_count && target_pool; i++) {
+            target_pool = pool_manager_merge_pools(
+              manager, target_pool->id, (int)pool_ids[i], geometry_type,
+              board_tiles);
+        }
+        if (!target_pool)
+            return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        tiles[i]->pool_id = target_pool->id;
+    }
+    pool_add_tiles(target_pool, tiles, count, geometry_type, board_tiles);
+    for (size_t i = 0; i < count; i++) {
+        pool_manager_track_tile_moved(manager, tiles[i], NULL, target_pool,
+                                      geometry_type, board_tiles);
+    }
+    pool_manager_update_score(manager, target_pool);
+    return target_pool;
+}
+
 void pool_manager_update_affected_pools(pool_manager_t *manager,
                                         grid_cell_t *affected_cells,
                                         size_t num_affected,
@@ -293,17 +659,16 @@ void pool_manager_update_affected_pools(pool_manager_t *manager,
     for (size_t i = 0; i < num_affected; i++) {
         int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
         grid_cell_t neighbor_cells[neighbor_count];
-        grid_geometry_get_all_neighbors(geometry_type, affected_cells[i],
-                                        neighbor_cells);
+        hex_kernel_grid_neighbors(geometry_type, affected_cells[i],
+                                  neighbor_cells);
 
         for (int j = 0; j < neighbor_count; j++) {
-            tile_map_entry_t *entry =
-              tile_map_find(board_tiles, neighbor_cells[j]);
-            if (entry && entry->tile && entry->tile->pool_id > 0) {
+            tile_t *neighbor = tile_map_get(board_tiles, neighbor_cells[j]);
+            if (neighbor && pool_manager_tile_pool_id(manager, neighbor) > 0) {
                 // Check if we already have this pool ID
                 bool already_added = false;
                 for (size_t k = 0; k < num_pools_to_update; k++) {
-                    if (pools_to_update[k] == (int)entry->tile->pool_id) {
+                    if (pools_to_update[k] == (int)neighbor->pool_id) {
                         already_added = true;
                         break;
                     }
@@ -311,8 +676,7 @@ void pool_manager_update_affected_pools(pool_manager_t *manager,
 
                 if (!already_added &&
                     num_pools_to_update < MAX_POOLS_TO_UPDATE) {
-                    pools_to_update[num_pools_to_update++] =
-                      entry->tile->pool_id;
+                    pools_to_update[num_pools_to_update++] = neighbor->pool_id;
                 }
             }
         }
@@ -322,7 +686,7 @@ void pool_manager_update_affected_pools(pool_manager_t *manager,
     for (size_t i = 0; i < num_pools_to_update; i++) {
         pool_t *pool = pool_manager_get_pool(manager, pools_to_update[i]);
         if (pool) {
-            pool_update_neighbors(pool, board_tiles, geometry_type);
+            pool_invalidate_neighbor_tiles(pool);
         }
     }
 }
@@ -339,22 +703,206 @@ void pool_manager_get_neighbor_pools(pool_manager_t *manager, grid_cell_t cell,
 
     int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
     grid_cell_t neighbor_cells[neighbor_count];
-    grid_geometry_get_all_neighbors(geometry_type, cell, neighbor_cells);
+    hex_kernel_grid_neighbors(geometry_type, cell, neighbor_cells);
 
     for (int i = 0; i < neighbor_count; i++) {
-        tile_map_entry_t *entry = tile_map_find(board_tiles, neighbor_cells[i]);
-        if (entry && entry->tile && entry->tile->pool_id > 0) {
+        tile_t *neighbor = tile_map_get(board_tiles, neighbor_cells[i]);
+        if (neighbor && pool_manager_tile_pool_id(manager, neighbor) > 0) {
             // Check for duplicates
             bool is_duplicate = false;
             for (size_t j = 0; j < *out_count; j++) {
-                if (out_pool_ids[j] == entry->tile->pool_id) {
+                if (out_pool_ids[j] == neighbor->pool_id) {
                     is_duplicate = true;
                     break;
                 }
             }
             if (!is_duplicate) {
-                out_pool_ids[(*out_count)++] = entry->tile->pool_id;
+                out_pool_ids[(*out_count)++] = neighbor->pool_id;
             }
         }
     }
 }
+
+void pool_manager_track_tile_moved(pool_manager_t *manager, const tile_t *tile,
+                                   pool_t *from, pool_t *to,
+                                   grid_type_e geometry_type,
+                                   const tile_map_t *board_tiles) {
+    if (!manager || !tile || !board_tiles || from == to)
+        return;
+
+    // Same-type neighbors end up in the tile's own pool, so only the
+    // other-type ones can link it to another pool
+    uint8_t other_type = tile->neighbor_mask & ~tile->same_type_mask;
+    if (!other_type)
+        return;
+
+    int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbor_cells[neighbor_count];
+    hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbor_cells);
+    for (int i = 0; i < neighbor_count; i++) {
+        if (!(other_type & (1u << i)))
+            continue;
+        tile_t *neighbor = tile_map_get(board_tiles, neighbor_cells[i]);
+        if (!neighbor || pool_manager_tile_pool_id(manager, neighbor) == 0)
+            continue;
+        pool_t *other = pool_manager_get_pool(manager, neighbor->pool_id);
+        pool_adjacency_add(from, other, -1);
+        pool_adjacency_add(to, other, 1);
+    }
+}
+
+void pool_manager_rebuild_adjacency(pool_manager_t *manager,
+                                    grid_type_e geometry_type,
+                                    const tile_map_t *board_tiles) {
+    if (!manager || !board_tiles)
+        return;
+
+    pool_manager_entry_t *entry, *tmp;
+    HASH_ITER(hh, manager->root, entry, tmp) {
+        pool_adjacency_clear(entry->pool);
+    }
+
+    // Every touching pair of tiles is seen from both sides; it is counted
+    // from the side whose pool has the lower id
+    int neighbor_count = grid_geometry_get_neighbor_count(geometry_type);
+    grid_cell_t neighbor_cells[neighbor_count];
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(board_tiles, tile, iter) {
+        uint8_t other_type = tile->neighbor_mask & ~tile->same_type_mask;
+        if (!other_type || pool_manager_tile_pool_id(manager, tile) == 0)
+            continue;
+        pool_t *pool = pool_manager_get_pool(manager, tile->pool_id);
+        if (!pool)
+            continue;
+
+        hex_kernel_grid_neighbors(geometry_type, tile->cell, neighbor_cells);
+        for (int i = 0; i < neighbor_count; i++) {
+            if (!(other_type & (1u << i)))
+                continue;
+            tile_t *neighbor = tile_map_get(board_tiles, neighbor_cells[i]);
+            if (!neighbor || pool_manager_tile_pool_id(manager, neighbor) <=
+                               (uint32_t)pool->id)
+                continue;
+            pool_adjacency_add(
+              pool, pool_manager_get_pool(manager, neighbor->pool_id), 1);
+        }
+    }
+}
+
+size_t pool_manager_get_adjacent_pools(pool_manager_t *manager,
+                                       uint32_t pool_id, tile_type_t type,
+                                       pool_t **out_pools, size_t max_pools) {
+    pool_t *pool = pool_manager_get_pool(manager, (int)pool_id);
+    return pool_get_adjacent_pools(pool, type, out_pools, max_pools);
+}
+
+void pool_manager_update_score(pool_manager_t *manager, pool_t *pool) {
+    if (!manager || !pool || !pool_leaderboard_contains(manager, pool))
+        return;
+    pool_get_score(pool);
+    pool_leaderboard_sift_up(manager, pool->leaderboard_index);
+    pool_leaderboard_sift_down(manager, pool->leaderboard_index);
+}
+
+void pool_manager_set_pool_modifier(pool_manager_t *manager, pool_t *pool,
+                                    float modifier) {
+    pool_set_modifier(pool, modifier);
+    pool_manager_update_score(manager, pool);
+}
+
+void pool_manager_add_pool_modifier(pool_manager_t *manager, pool_t *pool,
+                                    float modifier_delta) {
+    pool_add_modifier(pool, modifier_delta);
+    pool_manager_update_score(manager, pool);
+}
+
+void pool_manager_rebuild_leaderboard(pool_manager_t *manager) {
+    if (!manager)
+        return;
+    size_t size = kv_size(manager->leaderboard);
+    for (size_t i = 0; i < size; i++) {
+        pool_get_score(kv_A(manager->leaderboard, i));
+    }
+    for (size_t i = size / 2; i-- > 0;) {
+        pool_leaderboard_sift_down(manager, i);
+    }
+}
+
+// Candidate heap for pool_manager_top_pools: leaderboard slots, best first
+static void pool_top_push(pool_manager_t *manager, size_t *candidates,
+                          size_t *count, size_t slot) {
+    pool_t *pool = kv_A(manager->leaderboard, slot);
+    size_t index = (*count)++;
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!pool_leaderboard_before(
+              pool, kv_A(manager->leaderboard, candidates[parent])))
+            break;
+        candidates[index] = candidates[parent];
+        index = parent;
+    }
+    candidates[index] = slot;
+}
+
+static size_t pool_top_pop(pool_manager_t *manager, size_t *candidates,
+                           size_t *count) {
+    size_t top = candidates[0];
+    size_t slot = candidates[--(*count)];
+    pool_t *pool = kv_A(manager->leaderboard, slot);
+    size_t index = 0;
+    for (;;) {
+        size_t child = 2 * index + 1;
+        if (child >= *count)
+            break;
+        if (child + 1 < *count &&
+            pool_leaderboard_before(
+              kv_A(manager->leaderboard, candidates[child + 1]),
+              kv_A(manager->leaderboard, candidates[child])))
+            child++;
+        if (!pool_leaderboard_before(
+              kv_A(manager->leaderboard, candidates[child]), pool))
+            break;
+        candidates[index] = candidates[child];
+        index = child;
+    }
+    if (*count > 0)
+        candidates[index] = slot;
+    return top;
+}
+
+size_t pool_manager_top_pools(pool_manager_t *manager, pool_t **out_pools,
+                              size_t max_pools) {
+    if (!manager || !out_pools || max_pools == 0 ||
+        kv_size(manager->leaderboard) == 0)
+        return 0;
+
+    // Best-first walk of the leaderboard: the candidates are the slots whose
+    // parents were already output, so only O(k) slots are ever touched
+    size_t *candidates = malloc((max_pools + 1) * sizeof(size_t));
+    if (!candidates) {
+        fprintf(stderr, "Out of memory!\n");
+        return 0;
+    }
+    size_t candidate_count = 0;
+    pool_top_push(manager, candidates, &candidate_count, 0);
+
+    size_t size = kv_size(manager->leaderboard);
+    size_t count = 0;
+    while (count < max_pools && candidate_count > 0) {
+        size_t slot = pool_top_pop(manager, candidates, &candidate_count);
+        out_pools[count++] = kv_A(manager->leaderboard, slot);
+        for (size_t child = 2 * slot + 1; child <= 2 * slot + 2; child++) {
+            if (child < size)
+                pool_top_push(manager, candidates, &candidate_count, child);
+        }
+    }
+    free(candidates);
+    return count;
+}
+
+pool_t *pool_manager_best_pool(const pool_manager_t *manager) {
+    if (!manager || kv_size(manager->leaderboard) == 0)
+        return NULL;
+    return kv_A(manager->leaderboard, 0);
+}
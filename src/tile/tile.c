@@ -8,10 +8,8 @@
 
 tile_t *tile_create_ptr(grid_cell_t cell, tile_data_t data) {
     tile_t *t = malloc(sizeof(tile_t));
-    if (t) {
-        t->cell = cell;
-        t->data = data;
-    }
+    if (t)
+        *t = (tile_t){.cell = cell, .data = data};
     return t;
 }
 
@@ -2,22 +2,183 @@
 
 #include "../../include/grid/grid_cell_utils.h"
 #include "../../include/grid/grid_geometry.h"
+#include "../../include/grid/hex_kernels.h"
+#include "../../include/grid/hex_stencil.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+tile_map_key_t tile_map_key_from_cell(grid_cell_t cell) {
+  return ((tile_map_key_t)(uint32_t)cell.coord.hex.q << 32) |
+         (tile_map_key_t)(uint32_t)cell.coord.hex.r;
+}
+
+// 64-bit finalizer (MurmurHash3 fmix64). Neighbouring cells differ in only a
+// few key bits, so the mix spreads them across the low bits uthash uses to
+// pick a bucket.
+static inline unsigned tile_map_hash_key(tile_map_key_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return (unsigned)key;
+}
+
+static tile_map_entry_t *tile_map_find_key(const tile_map_t *map,
+                                           tile_map_key_t key) {
+  tile_map_entry_t *entry;
+  HASH_FIND_BYHASHVALUE(hh, map->root, &key, sizeof(key),
+                        tile_map_hash_key(key), entry);
+  return entry;
+}
+
+static void tile_map_insert_entry(tile_map_t *map, tile_map_entry_t *entry) {
+  HASH_ADD_BYHASHVALUE(hh, map->root, key, sizeof(entry->key),
+                       tile_map_hash_key(entry->key), entry);
+  map->num_tiles++;
+}
+
 tile_map_t *tile_map_create(void) {
   tile_map_t *map = malloc(sizeof(tile_map_t));
   if (!map) {
     fprintf(stderr, "Out of memory!\n");
     return NULL;
   }
+  map->backend = TILE_MAP_BACKEND_HASH;
   map->root = NULL;
+  map->cells = NULL;
+  map->radius = 0;
+  map->stride = 0;
+  map->order = TILE_MAP_ORDER_ROWS;
+  map->slot_count = 0;
+  map->stencil_deltas = NULL;
   map->num_tiles = 0;
+  map->entry_slab = NULL;
+  map->tile_slab = NULL;
+  return map;
+}
+
+// Entries and copied tiles are carved from per-map slabs, created on first use
+// so dense maps and maps that never copy tiles pay nothing for them.
+#define TILE_MAP_SLAB_CHUNK 256
+
+// Returns '*slab', creating it on first use.
+static slab_t *tile_map_slab(slab_t **slab, size_t object_size) {
+  if (!*slab)
+    *slab = slab_create(object_size, TILE_MAP_SLAB_CHUNK);
+  return *slab;
+}
+
+// Makes room for 'count' objects in one block, so a bulk load is contiguous.
+// Later chunks stay TILE_MAP_SLAB_CHUNK objects.
+static bool tile_map_reserve_slab(slab_t **slab, size_t object_size,
+                                  size_t count) {
+  return tile_map_slab(slab, object_size) && slab_reserve(*slab, count);
+}
+
+static tile_map_entry_t *tile_map_alloc_entry(tile_map_t *map) {
+  return slab_alloc(tile_map_slab(&map->entry_slab, sizeof(tile_map_entry_t)));
+}
+
+static tile_t *tile_map_alloc_tile_copy(tile_map_t *map, const tile_t *tile) {
+  tile_t *copy = slab_alloc(tile_map_slab(&map->tile_slab, sizeof(tile_t)));
+  if (copy)
+    *copy = *tile; // Copy tile data including position
+  return copy;
+}
+
+uint32_t tile_map_morton_encode(uint32_t x, uint32_t y) {
+  // Spread the low 16 bits of each coordinate to the even bit positions
+  x &= 0xffff;
+  x = (x | (x << 8)) & 0x00ff00ff;
+  x = (x | (x << 4)) & 0x0f0f0f0f;
+  x = (x | (x << 2)) & 0x33333333;
+  x = (x | (x << 1)) & 0x55555555;
+  y &= 0xffff;
+  y = (y | (y << 8)) & 0x00ff00ff;
+  y = (y | (y << 4)) & 0x0f0f0f0f;
+  y = (y | (y << 2)) & 0x33333333;
+  y = (y | (y << 1)) & 0x55555555;
+  return x | (y << 1);
+}
+
+tile_map_t *tile_map_create_dense(int radius) {
+  return tile_map_create_dense_ordered(radius, TILE_MAP_ORDER_ROWS);
+}
+
+tile_map_t *tile_map_create_dense_ordered(int radius, tile_map_order_e order) {
+  // Morton codes are 32 bits wide, so each axis is limited to 16 bits
+  if (radius < 0 || (order == TILE_MAP_ORDER_MORTON && 2 * radius + 1 > 0xffff))
+    return NULL;
+  tile_map_t *map = tile_map_create();
+  if (!map)
+    return NULL;
+  map->backend = TILE_MAP_BACKEND_DENSE;
+  map->radius = radius;
+  map->stride = 2 * radius + 1;
+  map->order = order;
+  if (order == TILE_MAP_ORDER_MORTON) {
+    // The curve covers a power-of-two square around the rhombus
+    int side = 1;
+    while (side < map->stride)
+      side <<= 1;
+    map->slot_count = side * side;
+  } else {
+    map->slot_count = map->stride * map->stride;
+  }
+  map->cells = calloc((size_t)map->slot_count, sizeof(tile_t *));
+  if (!map->cells) {
+    fprintf(stderr, "Out of memory!\n");
+    free(map);
+    return NULL;
+  }
+  if (order == TILE_MAP_ORDER_ROWS) {
+    // In row-major order an axial offset is a fixed slot delta
+    map->stencil_deltas = malloc(HEX_STENCIL_SIZE * sizeof(int));
+    if (!map->stencil_deltas) {
+      fprintf(stderr, "Out of memory!\n");
+      free(map->cells);
+      free(map);
+      return NULL;
+    }
+    for (int i = 0; i < HEX_STENCIL_SIZE; i++) {
+      map->stencil_deltas[i] =
+        hex_stencil_offsets[i].dr * map->stride + hex_stencil_offsets[i].dq;
+    }
+  }
   return map;
 }
 
+tile_map_t *tile_map_create_like(const tile_map_t *source) {
+  if (source && source->backend == TILE_MAP_BACKEND_DENSE)
+    return tile_map_create_dense_ordered(source->radius, source->order);
+  return tile_map_create();
+}
+
+int tile_map_dense_index(const tile_map_t *map, grid_cell_t cell) {
+  if (!map || map->backend != TILE_MAP_BACKEND_DENSE)
+    return -1;
+  int q = cell.coord.hex.q;
+  int r = cell.coord.hex.r;
+  int s = -q - r;
+  if (abs(q) > map->radius || abs(r) > map->radius || abs(s) > map->radius)
+    return -1;
+  if (map->order == TILE_MAP_ORDER_MORTON)
+    return (int)tile_map_morton_encode((uint32_t)(q + map->radius),
+                                       (uint32_t)(r + map->radius));
+  return (r + map->radius) * map->stride + (q + map->radius);
+}
+
+bool tile_map_in_bounds(const tile_map_t *map, grid_cell_t cell) {
+  if (!map)
+    return false;
+  if (map->backend == TILE_MAP_BACKEND_HASH)
+    return true;
+  return tile_map_dense_index(map, cell) >= 0;
+}
+
 bool tile_map_contains(const tile_map_t *map, grid_cell_t cell) {
-  return (tile_map_find((tile_map_t *)map, cell) != NULL);
+  return (tile_map_get(map, cell) != NULL);
 }
 
 int tile_map_size(const tile_map_t *map) { return map->num_tiles; }
@@ -25,234 +186,488 @@ int tile_map_size(const tile_map_t *map) { return map->num_tiles; }
 void tile_map_free(tile_map_t *map) {
   if (!map)
     return;
-  tile_map_entry_t *current_entry, *tmp_entry;
-  HASH_ITER(hh, map->root, current_entry, tmp_entry) {
-    HASH_DEL(map->root, current_entry);
-    free(current_entry);
-  }
+  // Entries live in the slab, so only the table itself needs tearing down
+  HASH_CLEAR(hh, map->root);
+  slab_destroy(map->entry_slab);
+  slab_destroy(map->tile_slab);
+  free(map->cells);
+  free(map->stencil_deltas);
   map->num_tiles = 0;
   free(map);
 }
 
-tile_map_entry_t *tile_map_find(const tile_map_t *map, grid_cell_t cell) {
+static tile_map_entry_t *tile_map_find(const tile_map_t *map,
+                                       grid_cell_t cell) {
+  return tile_map_find_key(map, tile_map_key_from_cell(cell));
+}
+
+tile_t *tile_map_get(const tile_map_t *map, grid_cell_t cell) {
   if (!map)
     return NULL;
-  tile_map_entry_t *entry;
-  for (entry = map->root; entry != NULL; entry = entry->hh.next) {
-    if (grid_cells_equal(&entry->cell, &cell))
-      return entry;
+  if (map->backend == TILE_MAP_BACKEND_DENSE) {
+    int index = tile_map_dense_index(map, cell);
+    return index >= 0 ? map->cells[index] : NULL;
+  }
+  tile_map_entry_t *entry = tile_map_find(map, cell);
+  return entry ? entry->tile : NULL;
+}
+
+// Slot of 'center' when every cell within 'range' of it has a slot at a
+// fixed delta, or -1. Only row-major dense maps qualify, and only when the
+// range stays inside the slot square on both axes, so no delta can wrap into
+// a neighboring row. Corner slots outside the hexagon are always empty.
+static int tile_map_stencil_base(const tile_map_t *map, grid_cell_t center,
+                                 int range) {
+  if (!map->stencil_deltas || range > HEX_STENCIL_MAX_RADIUS ||
+      center.type != GRID_TYPE_HEXAGON)
+    return -1;
+  int q = center.coord.hex.q;
+  int r = center.coord.hex.r;
+  int limit = map->radius - range;
+  if (q < -limit || q > limit || r < -limit || r > limit)
+    return -1;
+  return (r + map->radius) * map->stride + (q + map->radius);
+}
+
+// Stencil entries [begin, end) around 'center', empty cells skipped
+static size_t tile_map_gather_stencil(const tile_map_t *map,
+                                      grid_cell_t center, int begin, int end,
+                                      int base, tile_t **out_tiles) {
+  size_t count = 0;
+  if (base >= 0) {
+    tile_t *const *cells = map->cells + base;
+    const int *deltas = map->stencil_deltas;
+    for (int i = begin; i < end; i++) {
+      tile_t *tile = cells[deltas[i]];
+      out_tiles[count] = tile;
+      count += tile != NULL;
+    }
+    return count;
+  }
+  if (map->stencil_deltas) {
+    // Near the edge of a row-major map: clip each offset to the slot square
+    unsigned stride = (unsigned)map->stride;
+    int q = center.coord.hex.q + map->radius;
+    int r = center.coord.hex.r + map->radius;
+    for (int i = begin; i < end; i++) {
+      unsigned sq = (unsigned)(q + hex_stencil_offsets[i].dq);
+      unsigned sr = (unsigned)(r + hex_stencil_offsets[i].dr);
+      if (sq >= stride || sr >= stride)
+        continue;
+      tile_t *tile = map->cells[sr * stride + sq];
+      out_tiles[count] = tile;
+      count += tile != NULL;
+    }
+    return count;
+  }
+  for (int i = begin; i < end; i++) {
+    tile_t *tile = tile_map_get(map, hex_stencil_cell(center, i));
+    if (tile)
+      out_tiles[count++] = tile;
+  }
+  return count;
+}
+
+// Collects every ring up to 'range' around 'center', for ranges the stencil
+// table does not cover
+static size_t tile_map_gather_rings(const tile_map_t *map, grid_cell_t center,
+                                    int range, tile_t **out_tiles) {
+  size_t count = 0;
+  for (int radius = 0; radius <= range; radius++) {
+    int ring_size = radius == 0 ? 1 : 6 * radius;
+    for (int i = 0; i < ring_size; i++) {
+      hex_coord_t h = hex_kernel_ring_cell(center.coord.hex, radius, i);
+      tile_t *tile = tile_map_get(map, hex_kernel_cell(h));
+      if (tile)
+        out_tiles[count++] = tile;
+    }
+  }
+  return count;
+}
+
+size_t tile_map_collect_range(const tile_map_t *map, grid_cell_t center,
+                              int range, tile_t **out_tiles) {
+  if (!map || !out_tiles || range < 0 || center.type != GRID_TYPE_HEXAGON)
+    return 0;
+  if (range > HEX_STENCIL_MAX_RADIUS)
+    return tile_map_gather_rings(map, center, range, out_tiles);
+  int base = tile_map_stencil_base(map, center, range);
+  return tile_map_gather_stencil(map, center, 0, HEX_STENCIL_COUNT(range),
+                                 base, out_tiles);
+}
+
+int tile_map_count_range(const tile_map_t *map, grid_cell_t center, int range,
+                         int type) {
+  if (!map || range < 1 || center.type != GRID_TYPE_HEXAGON)
+    return 0;
+
+  int count = 0;
+  if (range > HEX_STENCIL_MAX_RADIUS) {
+    // Beyond the table, walk the rings cell by cell
+    for (int radius = 1; radius <= range; radius++) {
+      for (int i = 0; i < 6 * radius; i++) {
+        hex_coord_t h = hex_kernel_ring_cell(center.coord.hex, radius, i);
+        tile_t *tile = tile_map_get(map, hex_kernel_cell(h));
+        count += tile && (type < 0 || (int)tile->data.type == type);
+      }
+    }
+    return count;
+  }
+
+  tile_t *found[HEX_STENCIL_SIZE];
+  int base = tile_map_stencil_base(map, center, range);
+  size_t n = tile_map_gather_stencil(map, center, 1, HEX_STENCIL_COUNT(range),
+                                     base, found);
+  for (size_t i = 0; i < n; i++) {
+    count += type < 0 || (int)found[i]->data.type == type;
   }
-  return NULL;
+  return count;
 }
 
 void tile_map_remove(tile_map_t *map, grid_cell_t cell) {
   if (!map)
     return;
-  tile_map_entry_t *entry = tile_map_find((const tile_map_t *)map, cell);
+  if (map->backend == TILE_MAP_BACKEND_DENSE) {
+    int index = tile_map_dense_index(map, cell);
+    if (index >= 0 && map->cells[index]) {
+      map->cells[index] = NULL;
+      map->num_tiles--;
+    }
+    return;
+  }
+  tile_map_entry_t *entry = tile_map_find(map, cell);
   if (entry) {
     HASH_DEL(map->root, entry);
     map->num_tiles--;
-    free(entry);
+    slab_release(map->entry_slab, entry);
+  }
+}
+
+void tile_map_iter_init(tile_map_iter_t *iter, const tile_map_t *map) {
+  iter->map = map;
+  iter->next_entry = map ? map->root : NULL;
+  iter->next_index = 0;
+}
+
+tile_t *tile_map_iter_next(tile_map_iter_t *iter) {
+  const tile_map_t *map = iter->map;
+  if (!map)
+    return NULL;
+  if (map->backend == TILE_MAP_BACKEND_DENSE) {
+    int slot_count = map->slot_count;
+    while (iter->next_index < slot_count) {
+      tile_t *tile = map->cells[iter->next_index++];
+      if (tile)
+        return tile;
+    }
+    return NULL;
   }
+  tile_map_entry_t *entry = iter->next_entry;
+  if (!entry)
+    return NULL;
+  // Step past the entry before handing it out so the caller may remove it
+  iter->next_entry = entry->hh.next;
+  return entry->tile;
 }
 
 void tile_map_foreach_tile(tile_map_t *map, void (*fn)(tile_t *, void *),
                            void *user_data) {
   if (!map)
     return;
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, map->root, entry, tmp) { fn(entry->tile, user_data); }
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(map, tile, iter) { fn(tile, user_data); }
+}
+
+// Stores 'tile' in an empty dense slot or replaces the tile already there.
+// Returns false, storing nothing, if the cell is outside the map's radius.
+static bool tile_map_dense_set(tile_map_t *map, tile_t *tile) {
+  int index = tile_map_dense_index(map, tile->cell);
+  if (index < 0) {
+    fprintf(stderr, "Tile outside dense tile map radius %d\n", map->radius);
+    return false;
+  }
+  if (!map->cells[index])
+    map->num_tiles++;
+  map->cells[index] = tile;
+  return true;
 }
+
 void tile_map_add(tile_map_t *map, tile_t *tile) {
   if (!map || !tile)
     return;
-  tile_map_entry_t *existing_entry =
-    tile_map_find((const tile_map_t *)map, tile->cell);
+  if (map->backend == TILE_MAP_BACKEND_DENSE) {
+    tile_map_dense_set(map, tile);
+    return;
+  }
+  tile_map_key_t key = tile_map_key_from_cell(tile->cell);
+  tile_map_entry_t *existing_entry = tile_map_find_key(map, key);
   if (existing_entry) {
     // Update the tile pointer in the existing entry
     existing_entry->tile = tile;
   } else {
-    tile_map_entry_t *entry = malloc(sizeof(tile_map_entry_t));
+    tile_map_entry_t *entry = tile_map_alloc_entry(map);
     if (!entry) {
       fprintf(stderr, "Out of memory!\n");
       return;
     }
+    entry->key = key;
     entry->cell = tile->cell;
     entry->tile = tile;
-    HASH_ADD(hh, map->root, cell, sizeof(entry->cell), entry);
-    map->num_tiles++;
+    tile_map_insert_entry(map, entry);
   }
 }
 
 void tile_map_add_unchecked(tile_map_t *map, tile_t *tile) {
   if (!map || !tile)
     return;
+  if (map->backend == TILE_MAP_BACKEND_DENSE) {
+    tile_map_dense_set(map, tile);
+    return;
+  }
 
-  tile_map_entry_t *entry = malloc(sizeof(tile_map_entry_t));
+  tile_map_entry_t *entry = tile_map_alloc_entry(map);
   if (!entry) {
     fprintf(stderr, "Out of memory!\n");
     return;
   }
+  entry->key = tile_map_key_from_cell(tile->cell);
   entry->cell = tile->cell;
   entry->tile = tile;
-  HASH_ADD(hh, map->root, cell, sizeof(entry->cell), entry);
-  map->num_tiles++;
+  tile_map_insert_entry(map, entry);
 }
 
-bool tile_map_apply_offset(tile_map_t *tile_map, grid_cell_t offset) {
-  if (!tile_map)
-    return false;
-
-  if (tile_map->num_tiles == 0)
-    return true; // Nothing to offset
+// Smallest power of two >= count (uthash bucket counts are powers of two).
+static size_t tile_map_bucket_target(size_t count) {
+  size_t buckets = HASH_INITIAL_NUM_BUCKETS;
+  while (buckets < count)
+    buckets <<= 1;
+  return buckets;
+}
 
-  // Collect current tiles and their coordinates
-  tile_t **tiles = malloc(tile_map->num_tiles * sizeof(tile_t *));
-  grid_cell_t *old_coords = malloc(tile_map->num_tiles * sizeof(grid_cell_t));
-  grid_cell_t *new_coords = malloc(tile_map->num_tiles * sizeof(grid_cell_t));
+// Inserts a tile whose cell is known to be free. Once the hash table exists it
+// is grown straight to 'bucket_target' buckets, so a run of these inserts
+// never goes through uthash's incremental doubling and rehashing.
+static bool tile_map_insert_new(tile_map_t *map, tile_t *tile,
+                                size_t bucket_target) {
+  if (map->backend == TILE_MAP_BACKEND_DENSE)
+    return tile_map_dense_set(map, tile);
 
-  if (!tiles || !old_coords || !new_coords) {
-    free(tiles);
-    free(old_coords);
-    free(new_coords);
+  tile_map_entry_t *entry = tile_map_alloc_entry(map);
+  if (!entry) {
+    fprintf(stderr, "Out of memory!\n");
     return false;
   }
+  entry->key = tile_map_key_from_cell(tile->cell);
+  entry->cell = tile->cell;
+  entry->tile = tile;
+  tile_map_insert_entry(map, entry);
 
-  // Extract tiles and coordinates
-  int count = 0;
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, tile_map->root, entry, tmp) {
-    tiles[count] = entry->tile;
-    old_coords[count] = entry->tile->cell;
-
-    // Calculate new coordinate with offset using grid geometry functions
-    // Assume hex for now - this should be parameterized
-    grid_cell_t new_coord =
-      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, entry->tile->cell, offset);
-    if (new_coord.type == GRID_TYPE_UNKNOWN) {
-      free(tiles);
-      free(old_coords);
-      free(new_coords);
-      return false;
-    }
-    new_coords[count] = new_coord;
-
-    count++;
+  // Reaches into uthash internals (tbl->num_buckets, tbl->noexpand and
+  // HASH_EXPAND_BUCKETS) as of the bundled uthash 2.3.0; recheck them when
+  // updating it. 'oomed' is only written when HASH_NONFATAL_OOM is set.
+  UT_hash_table *table = map->root->hh.tbl;
+  int oomed = 0;
+  (void)oomed;
+  while (table->num_buckets < bucket_target && !table->noexpand && !oomed) {
+    HASH_EXPAND_BUCKETS(hh, table, oomed);
   }
+  return true;
+}
 
-  // Check for conflicts between new positions
-  for (int i = 0; i < count; i++) {
-    for (int j = i + 1; j < count; j++) {
-      if (grid_geometry_cells_equal(GRID_TYPE_HEXAGON, new_coords[i],
-                                    new_coords[j])) {
-        free(tiles);
-        free(old_coords);
-        free(new_coords);
-        return false;
+bool tile_map_add_bulk(tile_map_t *map, tile_t *const *tiles, size_t count) {
+  if (!map || !tiles)
+    return false;
+  if (count == 0)
+    return true;
+
+  if (map->backend == TILE_MAP_BACKEND_HASH &&
+      !tile_map_reserve_slab(&map->entry_slab, sizeof(tile_map_entry_t),
+                             count))
+    return false;
+
+  size_t bucket_target = tile_map_bucket_target(map->num_tiles + count);
+  for (size_t i = 0; i < count; i++) {
+    if (tiles[i] && !tile_map_insert_new(map, tiles[i], bucket_target)) {
+      // Take back the tiles already inserted; their cells were free
+      for (size_t j = 0; j < i; j++) {
+        if (tiles[j])
+          tile_map_remove(map, tiles[j]->cell);
       }
+      return false;
     }
   }
+  return true;
+}
 
-  // Remove all tiles from their current positions
-  for (int i = 0; i < count; i++) {
-    tile_map_remove(tile_map, old_coords[i]);
+tile_map_t *tile_map_build_bulk(tile_t *const *tiles, size_t count) {
+  tile_map_t *map = tile_map_create();
+  if (!map)
+    return NULL;
+  if (!tile_map_add_bulk(map, tiles, count)) {
+    tile_map_free(map);
+    return NULL;
   }
+  return map;
+}
 
-  // Update tile positions and re-add them
-  for (int i = 0; i < count; i++) {
-    tiles[i]->cell = new_coords[i];
-    tile_map_add(tile_map, tiles[i]);
-  }
+static int tile_map_morton_compare(const tile_map_entry_t *a,
+                                   const tile_map_entry_t *b) {
+  // Offset into unsigned range so negative coordinates order correctly
+  uint32_t code_a =
+    tile_map_morton_encode((uint32_t)a->cell.coord.hex.q + 0x8000u,
+                           (uint32_t)a->cell.coord.hex.r + 0x8000u);
+  uint32_t code_b =
+    tile_map_morton_encode((uint32_t)b->cell.coord.hex.q + 0x8000u,
+                           (uint32_t)b->cell.coord.hex.r + 0x8000u);
+  return (code_a > code_b) - (code_a < code_b);
+}
 
-  free(tiles);
-  free(old_coords);
-  free(new_coords);
-  return true;
+void tile_map_sort_spatial(tile_map_t *map) {
+  if (!map || map->backend != TILE_MAP_BACKEND_HASH)
+    return;
+  HASH_SRT(hh, map->root, tile_map_morton_compare);
 }
 
-bool tile_map_rotate(tile_map_t *tile_map, grid_cell_t center,
-                     int rotation_steps) {
+tile_map_transform_t tile_map_transform_rotation(grid_cell_t center,
+                                                 int rotation_steps) {
+  tile_map_transform_t transform = {.rotation_steps = rotation_steps,
+                                    .center = center,
+                                    .offset = {.type = GRID_TYPE_HEXAGON}};
+  return transform;
+}
+
+tile_map_transform_t tile_map_transform_translation(grid_cell_t offset) {
+  tile_map_transform_t transform = {.rotation_steps = 0,
+                                    .center = {.type = GRID_TYPE_HEXAGON},
+                                    .offset = offset};
+  return transform;
+}
+
+grid_cell_t tile_map_transform_cell(const tile_map_transform_t *transform,
+                                    grid_cell_t cell) {
+  // Assume hex for now - this should be parameterized
+  int steps = ((transform->rotation_steps % 6) + 6) % 6;
+  const hex_coord_t *pivot = &transform->center.coord.hex;
+  int rel[3] = {cell.coord.hex.q - pivot->q, cell.coord.hex.r - pivot->r,
+                cell.coord.hex.s - pivot->s};
+
+  // k clockwise steps of (q, r, s) -> (-r, -s, -q) cycle the cube components
+  // by k and flip their sign when k is odd
+  int sign = (steps & 1) ? -1 : 1;
+  grid_cell_t out = {.type = GRID_TYPE_HEXAGON};
+  out.coord.hex.q =
+    sign * rel[steps % 3] + pivot->q + transform->offset.coord.hex.q;
+  out.coord.hex.r =
+    sign * rel[(steps + 1) % 3] + pivot->r + transform->offset.coord.hex.r;
+  out.coord.hex.s =
+    sign * rel[(steps + 2) % 3] + pivot->s + transform->offset.coord.hex.s;
+  return out;
+}
+
+bool tile_map_reindex(tile_map_t *tile_map) {
   if (!tile_map)
     return false;
-
   if (tile_map->num_tiles == 0)
-    return true; // Nothing to rotate
+    return true;
 
-  // Collect current tile coordinates
-  grid_cell_t *current_coords =
-    malloc(tile_map->num_tiles * sizeof(grid_cell_t));
-  tile_t **tiles = malloc(tile_map->num_tiles * sizeof(tile_t *));
+  if (tile_map->backend == TILE_MAP_BACKEND_DENSE) {
+    size_t slot_count = (size_t)tile_map->slot_count;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(tile_map, tile, iter) {
+      if (!tile_map_in_bounds(tile_map, tile->cell))
+        return false;
+    }
 
-  if (!current_coords || !tiles) {
-    free(current_coords);
-    free(tiles);
-    return false;
+    tile_t **cells = calloc(slot_count, sizeof(tile_t *));
+    if (!cells) {
+      fprintf(stderr, "Out of memory!\n");
+      return false;
+    }
+    TILE_MAP_ITER(tile_map, tile, iter) {
+      cells[tile_map_dense_index(tile_map, tile->cell)] = tile;
+    }
+    free(tile_map->cells);
+    tile_map->cells = cells;
+    return true;
   }
 
-  // Extract coordinates and tiles
-  int count = 0;
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, tile_map->root, entry, tmp) {
-    current_coords[count] = entry->tile->cell;
-    tiles[count] = entry->tile;
-    count++;
-  }
-
-  // Rotate each coordinate individually
-  grid_cell_t *rotated_coords = malloc(count * sizeof(grid_cell_t));
-  if (!rotated_coords) {
-    free(current_coords);
-    free(tiles);
+  // Detach every entry, drop the old table and re-add the same entries under
+  // their new keys
+  tile_map_entry_t **entries =
+    malloc(tile_map->num_tiles * sizeof(tile_map_entry_t *));
+  if (!entries) {
+    fprintf(stderr, "Out of memory!\n");
     return false;
   }
-
-  // Rotate each tile's position around the center
+  int count = 0;
+  for (tile_map_entry_t *entry = tile_map->root; entry;
+       entry = entry->hh.next) {
+    entries[count++] = entry;
+  }
+  HASH_CLEAR(hh, tile_map->root);
+  tile_map->num_tiles = 0;
   for (int i = 0; i < count; i++) {
-    // Calculate offset from center
-    grid_cell_t offset = grid_geometry_calculate_offset(
-      GRID_TYPE_HEXAGON, center, current_coords[i]);
-    // Rotate the offset
-    grid_cell_t rotated_offset;
-    if (!grid_geometry_rotate_cell(GRID_TYPE_HEXAGON, offset, rotation_steps,
-                                   &rotated_offset)) {
-      free(current_coords);
-      free(tiles);
-      free(rotated_coords);
-      return false;
-    }
-    // Apply rotated offset back to center
-    rotated_coords[i] =
-      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, center, rotated_offset);
+    entries[i]->cell = entries[i]->tile->cell;
+    entries[i]->key = tile_map_key_from_cell(entries[i]->cell);
+    tile_map_insert_entry(tile_map, entries[i]);
   }
+  free(entries);
+  return true;
+}
 
-  // Check for conflicts between rotated positions
-  for (int i = 0; i < count; i++) {
-    for (int j = i + 1; j < count; j++) {
-      if (grid_geometry_cells_equal(GRID_TYPE_HEXAGON, rotated_coords[i],
-                                    rotated_coords[j])) {
-        free(current_coords);
-        free(tiles);
-        free(rotated_coords);
+bool tile_map_transform(tile_map_t *tile_map,
+                        const tile_map_transform_t *transform) {
+  if (!tile_map || !transform)
+    return false;
+
+  if (tile_map->num_tiles == 0)
+    return true; // Nothing to transform
+
+  tile_map_iter_t iter;
+  tile_t *tile;
+
+  // Check the destination radius before touching any tile
+  if (tile_map->backend == TILE_MAP_BACKEND_DENSE) {
+    TILE_MAP_ITER(tile_map, tile, iter) {
+      if (!tile_map_in_bounds(tile_map,
+                              tile_map_transform_cell(transform, tile->cell)))
         return false;
-      }
     }
   }
 
-  // Remove all tiles from their current positions
-  for (int i = 0; i < count; i++) {
-    tile_map_remove(tile_map, current_coords[i]);
+  // Keep the old cells so a failed re-index can be undone
+  grid_cell_t *old_cells = malloc(tile_map->num_tiles * sizeof(grid_cell_t));
+  if (!old_cells) {
+    fprintf(stderr, "Out of memory!\n");
+    return false;
+  }
+  int count = 0;
+  TILE_MAP_ITER(tile_map, tile, iter) {
+    old_cells[count++] = tile->cell;
+    tile->cell = tile_map_transform_cell(transform, tile->cell);
   }
 
-  // Update tile positions and re-add them
-  for (int i = 0; i < count; i++) {
-    tiles[i]->cell = rotated_coords[i];
-    tile_map_add(tile_map, tiles[i]);
+  bool success = tile_map_reindex(tile_map);
+  if (!success) {
+    count = 0;
+    TILE_MAP_ITER(tile_map, tile, iter) { tile->cell = old_cells[count++]; }
   }
+  free(old_cells);
+  return success;
+}
 
-  free(current_coords);
-  free(tiles);
-  free(rotated_coords);
-  return true;
+bool tile_map_apply_offset(tile_map_t *tile_map, grid_cell_t offset) {
+  tile_map_transform_t transform = tile_map_transform_translation(offset);
+  return tile_map_transform(tile_map, &transform);
+}
+
+bool tile_map_rotate(tile_map_t *tile_map, grid_cell_t center,
+                     int rotation_steps) {
+  tile_map_transform_t transform =
+    tile_map_transform_rotation(center, rotation_steps);
+  return tile_map_transform(tile_map, &transform);
 }
 
 bool tile_map_merge(tile_map_t *dest, const tile_map_t *source) {
@@ -263,23 +678,33 @@ bool tile_map_merge(tile_map_t *dest, const tile_map_t *source) {
     return true; // Nothing to merge
 
   // Check for conflicts with existing tiles in destination
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, source->root, entry, tmp) {
-    if (tile_map_contains(dest, entry->tile->cell)) {
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(source, tile, iter) {
+    if (!tile_map_in_bounds(dest, tile->cell) ||
+        tile_map_contains(dest, tile->cell)) {
       return false; // Conflict found
     }
   }
 
-  // Create copies of source tiles and add to destination
-  HASH_ITER(hh, source->root, entry, tmp) {
-    // Create a copy of the tile
-    tile_t *tile_copy = malloc(sizeof(tile_t));
-    if (!tile_copy) {
+  // Size the destination once, then copy source tiles into it
+  if (dest->backend == TILE_MAP_BACKEND_HASH &&
+      !tile_map_reserve_slab(&dest->entry_slab, sizeof(tile_map_entry_t),
+                             source->num_tiles))
+    return false;
+  if (!tile_map_reserve_slab(&dest->tile_slab, sizeof(tile_t),
+                             source->num_tiles))
+    return false;
+  size_t bucket_target =
+    tile_map_bucket_target((size_t)dest->num_tiles + source->num_tiles);
+
+  TILE_MAP_ITER(source, tile, iter) {
+    // Create a copy of the tile owned by the destination map
+    tile_t *tile_copy = tile_map_alloc_tile_copy(dest, tile);
+    if (!tile_copy ||
+        !tile_map_insert_new(dest, tile_copy, bucket_target)) {
       return false;
     }
-
-    *tile_copy = *entry->tile; // Copy tile data including position
-    tile_map_add(dest, tile_copy);
   }
 
   return true;
@@ -289,25 +714,35 @@ tile_map_t *tile_map_clone(const tile_map_t *source) {
   if (!source)
     return NULL;
 
-  tile_map_t *clone = tile_map_create();
+  tile_map_t *clone = tile_map_create_like(source);
   if (!clone)
     return NULL;
 
   if (source->num_tiles == 0)
     return clone; // Empty clone
 
-  // Iterate through source tiles and create copies
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, source->root, entry, tmp) {
-    // Create a copy of the tile
-    tile_t *tile_copy = malloc(sizeof(tile_t));
-    if (!tile_copy) {
+  // Size the clone once: one slab chunk for the entries, one for the copied
+  // tiles, and the final bucket count
+  size_t count = (size_t)source->num_tiles;
+  if ((clone->backend == TILE_MAP_BACKEND_HASH &&
+       !tile_map_reserve_slab(&clone->entry_slab, sizeof(tile_map_entry_t),
+                              count)) ||
+      !tile_map_reserve_slab(&clone->tile_slab, sizeof(tile_t), count)) {
+    tile_map_free(clone);
+    return NULL;
+  }
+  size_t bucket_target = tile_map_bucket_target(count);
+
+  // Source cells are distinct, so every copy goes in without a lookup
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(source, tile, iter) {
+    // Create a copy of the tile owned by the clone
+    tile_t *tile_copy = tile_map_alloc_tile_copy(clone, tile);
+    if (!tile_copy || !tile_map_insert_new(clone, tile_copy, bucket_target)) {
       tile_map_free(clone);
       return NULL;
     }
-
-    *tile_copy = *entry->tile; // Copy tile data including position
-    tile_map_add(clone, tile_copy);
   }
 
   return clone;
@@ -347,10 +782,11 @@ bool tile_map_find_overlaps(const tile_map_t *map1, const tile_map_t *map2,
   size_t overlap_count = 0;
 
   // Iterate through smaller map and check if coordinates exist in larger map
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, smaller_map->root, entry, tmp) {
-    if (tile_map_contains(larger_map, entry->tile->cell)) {
-      overlaps[overlap_count] = entry->tile->cell;
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(smaller_map, tile, iter) {
+    if (tile_map_contains(larger_map, tile->cell)) {
+      overlaps[overlap_count] = tile->cell;
       overlap_count++;
     }
   }
@@ -405,10 +841,11 @@ bool tile_map_find_merge_conflicts(const tile_map_t *source,
   size_t conflict_count = 0;
 
   // Check each source tile position after applying offset
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, source->root, entry, tmp) {
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(source, tile, iter) {
     grid_cell_t target_pos =
-      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, entry->tile->cell, offset);
+      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, tile->cell, offset);
 
     // Check if position is occupied in destination
     if (tile_map_contains(dest, target_pos)) {
@@ -448,10 +885,11 @@ bool tile_map_can_merge_with_offset(const tile_map_t *source,
     return true; // Empty source can always be merged
 
   // Check each source tile position after applying offset
-  tile_map_entry_t *entry, *tmp;
-  HASH_ITER(hh, source->root, entry, tmp) {
+  tile_map_iter_t iter;
+  tile_t *tile;
+  TILE_MAP_ITER(source, tile, iter) {
     grid_cell_t target_pos =
-      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, entry->tile->cell, offset);
+      grid_geometry_apply_offset(GRID_TYPE_HEXAGON, tile->cell, offset);
 
     // Check if position is occupied in destination
     if (tile_map_contains(dest, target_pos)) {
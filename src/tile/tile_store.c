@@ -0,0 +1,197 @@
+#include "tile/tile_store.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TILE_STORE_SSE2
+#include <emmintrin.h>
+#endif
+
+#define TILE_STORE_INITIAL_CAPACITY 64
+
+tile_store_t *tile_store_create(void) {
+    tile_store_t *store = calloc(1, sizeof(tile_store_t));
+    if (!store) {
+        fprintf(stderr, "Out of memory!\n");
+        return NULL;
+    }
+    return store;
+}
+
+void tile_store_free(tile_store_t *store) {
+    if (!store)
+        return;
+    free(store->types);
+    free(store->values);
+    free(store->modifiers);
+    free(store->pool_ids);
+    free(store->tiles);
+    free(store);
+}
+
+void tile_store_clear(tile_store_t *store) {
+    if (!store)
+        return;
+    store->count = 0;
+    store->pool_ids_dirty = false;
+}
+
+static bool tile_store_grow(tile_store_t *store) {
+    size_t capacity = store->capacity ? store->capacity * 2
+                                      : TILE_STORE_INITIAL_CAPACITY;
+
+    // Columns that grew keep their new block even if a later one fails; the
+    // capacity only advances once every column has room
+    int32_t *types = realloc(store->types, capacity * sizeof(int32_t));
+    if (types)
+        store->types = types;
+    int32_t *values = realloc(store->values, capacity * sizeof(int32_t));
+    if (values)
+        store->values = values;
+    float *modifiers = realloc(store->modifiers, capacity * sizeof(float));
+    if (modifiers)
+        store->modifiers = modifiers;
+    uint32_t *pool_ids = realloc(store->pool_ids, capacity * sizeof(uint32_t));
+    if (pool_ids)
+        store->pool_ids = pool_ids;
+    tile_t **tiles = realloc(store->tiles, capacity * sizeof(tile_t *));
+    if (tiles)
+        store->tiles = tiles;
+
+    if (!types || !values || !modifiers || !pool_ids || !tiles) {
+        fprintf(stderr, "Out of memory!\n");
+        return false;
+    }
+    store->capacity = capacity;
+    return true;
+}
+
+bool tile_store_add(tile_store_t *store, tile_t *tile) {
+    if (!store || !tile)
+        return false;
+    if (store->count == store->capacity && !tile_store_grow(store))
+        return false;
+
+    size_t row = store->count++;
+    store->types[row] = (int32_t)tile->data.type;
+    store->values[row] = (int32_t)tile->data.value;
+    store->modifiers[row] = tile->data.modifier;
+    store->pool_ids[row] = tile->pool_id;
+    store->tiles[row] = tile;
+    tile->store_index = (uint32_t)row;
+    return true;
+}
+
+void tile_store_remove(tile_store_t *store, tile_t *tile) {
+    if (!store || !tile)
+        return;
+    size_t row = tile->store_index;
+    if (row >= store->count || store->tiles[row] != tile)
+        return;
+
+    size_t last = --store->count;
+    if (row != last) {
+        store->types[row] = store->types[last];
+        store->values[row] = store->values[last];
+        store->modifiers[row] = store->modifiers[last];
+        store->pool_ids[row] = store->pool_ids[last];
+        store->tiles[row] = store->tiles[last];
+        store->tiles[row]->store_index = (uint32_t)row;
+    }
+}
+
+void tile_store_sync_pool_ids(tile_store_t *store) {
+    if (!store)
+        return;
+    for (size_t i = 0; i < store->count; i++) {
+        store->pool_ids[i] = store->tiles[i]->pool_id;
+    }
+    store->pool_ids_dirty = false;
+}
+
+// Sums values[i] * modifiers[i] over rows whose key equals 'key', or over
+// every row when 'keys' is NULL. Lanes that fail the key test are zeroed
+// with a compare mask, so the loop has no data-dependent branches.
+static float tile_store_masked_production(const int32_t *keys, int32_t key,
+                                          const int32_t *values,
+                                          const float *modifiers, size_t n) {
+    size_t i = 0;
+    float sum = 0.0f;
+
+#if defined(__AVX2__)
+    __m256 acc = _mm256_setzero_ps();
+    __m256i key_vec = _mm256_set1_epi32(key);
+    for (; i + 8 <= n; i += 8) {
+        __m256 value =
+          _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)(values + i)));
+        __m256 product = _mm256_mul_ps(value, _mm256_loadu_ps(modifiers + i));
+        if (keys) {
+            __m256i match = _mm256_cmpeq_epi32(
+              _mm256_loadu_si256((const __m256i *)(keys + i)), key_vec);
+            product = _mm256_and_ps(product, _mm256_castsi256_ps(match));
+        }
+        acc = _mm256_add_ps(acc, product);
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc),
+                             _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    sum = _mm_cvtss_f32(half);
+#elif defined(TILE_STORE_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    __m128i key_vec = _mm_set1_epi32(key);
+    for (; i + 4 <= n; i += 4) {
+        __m128 value =
+          _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(values + i)));
+        __m128 product = _mm_mul_ps(value, _mm_loadu_ps(modifiers + i));
+        if (keys) {
+            __m128i match = _mm_cmpeq_epi32(
+              _mm_loadu_si128((const __m128i *)(keys + i)), key_vec);
+            product = _mm_and_ps(product, _mm_castsi128_ps(match));
+        }
+        acc = _mm_add_ps(acc, product);
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum = _mm_cvtss_f32(acc);
+#endif
+
+    // Scalar fallback and remainder
+    for (; i < n; i++) {
+        if (!keys || keys[i] == key)
+            sum += (float)values[i] * modifiers[i];
+    }
+    return sum;
+}
+
+void tile_store_sum_production(const tile_store_t *store,
+                               tile_store_production_t *out) {
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    if (!store || store->count == 0)
+        return;
+
+    out->total = tile_store_masked_production(NULL, 0, store->values,
+                                              store->modifiers, store->count);
+    for (int type = 0; type < TILE_TYPE_COUNT; type++) {
+        out->by_type[type] = tile_store_masked_production(
+          store->types, type, store->values, store->modifiers, store->count);
+    }
+}
+
+float tile_store_pool_production(tile_store_t *store, uint32_t pool_id) {
+    if (!store || store->count == 0)
+        return 0.0f;
+    if (store->pool_ids_dirty)
+        tile_store_sync_pool_ids(store);
+
+    // Pool ids are compared bit-for-bit, so the signed view is equivalent
+    return tile_store_masked_production((const int32_t *)store->pool_ids,
+                                        (int32_t)pool_id, store->values,
+                                        store->modifiers, store->count);
+}
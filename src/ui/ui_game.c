@@ -246,8 +246,11 @@ void ui_tile_info_card(game_controller_t *controller, Vector2 mouse_pos) {
                 CLAY_TEXT(pool_modifier, &TEXT_CONFIG_MEDIUM);
 
                 static char neighbor_tile_count[32];
+                size_t neighbor_count = 0;
+                pool_get_neighbor_tiles(pool, game->board->tiles,
+                                        &neighbor_count);
                 snprintf(neighbor_tile_count, sizeof(neighbor_tile_count),
-                         "Neighbors: %zu", pool->neighbor_tiles.n);
+                         "Neighbors: %zu", neighbor_count);
                 Clay_String neighbor_tiles = {.chars = neighbor_tile_count,
                                               .length =
                                                 strlen(neighbor_tile_count)};
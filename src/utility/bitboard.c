@@ -0,0 +1,186 @@
+#include "utility/bitboard.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline int bitboard_popcount(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+    bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+    bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int)((bits * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Locates a cell's row and column; false if it lies outside the radius.
+static bool bitboard_locate(const bitboard_t *bitboard, grid_cell_t cell,
+                            int *out_row, int *out_column) {
+    int q = cell.coord.hex.q;
+    int r = cell.coord.hex.r;
+    int radius = bitboard->radius;
+    if (q < -radius || q > radius || r < -radius || r > radius ||
+        q + r < -radius || q + r > radius)
+        return false;
+    *out_row = r + radius;
+    *out_column = q + radius;
+    return true;
+}
+
+bitboard_t *bitboard_create(int radius) {
+    if (radius < 0)
+        return NULL;
+
+    bitboard_t *bitboard = malloc(sizeof(bitboard_t));
+    if (!bitboard) {
+        fprintf(stderr, "Out of memory!\n");
+        return NULL;
+    }
+    bitboard->radius = radius;
+    bitboard->stride = 2 * radius + 1;
+    bitboard->words_per_row = (bitboard->stride + 63) / 64;
+    bitboard->count = 0;
+
+    size_t word_count = (size_t)bitboard->stride * bitboard->words_per_row;
+    bitboard->occupied = calloc(word_count, sizeof(uint64_t));
+    bitboard->valid = calloc(word_count, sizeof(uint64_t));
+    if (!bitboard->occupied || !bitboard->valid) {
+        fprintf(stderr, "Out of memory!\n");
+        bitboard_free(bitboard);
+        return NULL;
+    }
+
+    // Row r holds q in [max(-R, -R - r), min(R, R - r)]
+    for (int r = -radius; r <= radius; r++) {
+        int q_min = r < 0 ? -radius - r : -radius;
+        int q_max = r > 0 ? radius - r : radius;
+        uint64_t *row =
+          bitboard->valid + (size_t)(r + radius) * bitboard->words_per_row;
+        for (int q = q_min; q <= q_max; q++) {
+            int column = q + radius;
+            row[column / 64] |= 1ULL << (column % 64);
+        }
+    }
+    return bitboard;
+}
+
+void bitboard_free(bitboard_t *bitboard) {
+    if (!bitboard)
+        return;
+    free(bitboard->occupied);
+    free(bitboard->valid);
+    free(bitboard);
+}
+
+void bitboard_clear(bitboard_t *bitboard) {
+    if (!bitboard)
+        return;
+    memset(bitboard->occupied, 0,
+           (size_t)bitboard->stride * bitboard->words_per_row *
+             sizeof(uint64_t));
+    bitboard->count = 0;
+}
+
+bool bitboard_in_bounds(const bitboard_t *bitboard, grid_cell_t cell) {
+    int row, column;
+    return bitboard && bitboard_locate(bitboard, cell, &row, &column);
+}
+
+bool bitboard_test(const bitboard_t *bitboard, grid_cell_t cell) {
+    int row, column;
+    if (!bitboard || !bitboard_locate(bitboard, cell, &row, &column))
+        return false;
+    const uint64_t *words =
+      bitboard->occupied + (size_t)row * bitboard->words_per_row;
+    return (words[column / 64] >> (column % 64)) & 1;
+}
+
+bool bitboard_set(bitboard_t *bitboard, grid_cell_t cell) {
+    int row, column;
+    if (!bitboard || !bitboard_locate(bitboard, cell, &row, &column))
+        return false;
+    uint64_t *word = bitboard->occupied +
+                     (size_t)row * bitboard->words_per_row + column / 64;
+    uint64_t bit = 1ULL << (column % 64);
+    if (!(*word & bit)) {
+        *word |= bit;
+        bitboard->count++;
+    }
+    return true;
+}
+
+void bitboard_reset(bitboard_t *bitboard, grid_cell_t cell) {
+    int row, column;
+    if (!bitboard || !bitboard_locate(bitboard, cell, &row, &column))
+        return;
+    uint64_t *word = bitboard->occupied +
+                     (size_t)row * bitboard->words_per_row + column / 64;
+    uint64_t bit = 1ULL << (column % 64);
+    if (*word & bit) {
+        *word &= ~bit;
+        bitboard->count--;
+    }
+}
+
+// Bits [start, start + 64) of a row; columns outside the row read as zero.
+static inline uint64_t bitboard_row_window(const uint64_t *row, int words,
+                                           int start) {
+    int word = start >= 0 ? start / 64 : -((63 - start) / 64);
+    int shift = start - word * 64;
+    uint64_t low = (word >= 0 && word < words) ? row[word] : 0;
+    if (shift == 0)
+        return low;
+    uint64_t high = (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : 0;
+    return (low >> shift) | (high << (64 - shift));
+}
+
+size_t bitboard_count_overlap(const bitboard_t *board, const bitboard_t *piece,
+                              grid_cell_t offset, size_t *out_of_bounds) {
+    size_t overlap = 0;
+    size_t outside = 0;
+    if (!board || !piece) {
+        if (out_of_bounds)
+            *out_of_bounds = 0;
+        return 0;
+    }
+
+    // Piece column c is q + piece_radius; on the board that cell sits at
+    // column c + column_shift
+    int column_shift =
+      board->radius - piece->radius + offset.coord.hex.q;
+    for (int piece_row = 0; piece_row < piece->stride; piece_row++) {
+        const uint64_t *piece_words =
+          piece->occupied + (size_t)piece_row * piece->words_per_row;
+        int r = piece_row - piece->radius + offset.coord.hex.r;
+        bool row_inside = r >= -board->radius && r <= board->radius;
+        const uint64_t *board_occupied = NULL;
+        const uint64_t *board_valid = NULL;
+        if (row_inside) {
+            size_t row_start = (size_t)(r + board->radius) * board->words_per_row;
+            board_occupied = board->occupied + row_start;
+            board_valid = board->valid + row_start;
+        }
+
+        for (int w = 0; w < piece->words_per_row; w++) {
+            uint64_t bits = piece_words[w];
+            if (!bits)
+                continue;
+            if (!row_inside) {
+                outside += bitboard_popcount(bits);
+                continue;
+            }
+            int start = w * 64 + column_shift;
+            overlap += bitboard_popcount(
+              bits & bitboard_row_window(board_occupied, board->words_per_row,
+                                         start));
+            outside += bitboard_popcount(
+              bits & ~bitboard_row_window(board_valid, board->words_per_row,
+                                          start));
+        }
+    }
+
+    if (out_of_bounds)
+        *out_of_bounds = outside;
+    return overlap;
+}
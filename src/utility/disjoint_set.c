@@ -0,0 +1,79 @@
+#include "utility/disjoint_set.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DISJOINT_SET_INITIAL_CAPACITY 64
+
+disjoint_set_t *disjoint_set_create(void) {
+    disjoint_set_t *set = calloc(1, sizeof(disjoint_set_t));
+    if (!set) {
+        fprintf(stderr, "Out of memory!\n");
+        return NULL;
+    }
+    return set;
+}
+
+void disjoint_set_free(disjoint_set_t *set) {
+    if (!set)
+        return;
+    free(set->parent);
+    free(set->size);
+    free(set);
+}
+
+bool disjoint_set_make(disjoint_set_t *set, uint32_t *out_id) {
+    if (!set || set->count == UINT32_MAX)
+        return false;
+
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2
+                                        : DISJOINT_SET_INITIAL_CAPACITY;
+        uint32_t *parent = realloc(set->parent, capacity * sizeof(uint32_t));
+        if (parent)
+            set->parent = parent;
+        uint32_t *size = realloc(set->size, capacity * sizeof(uint32_t));
+        if (size)
+            set->size = size;
+        if (!parent || !size) {
+            fprintf(stderr, "Out of memory!\n");
+            return false;
+        }
+        set->capacity = capacity;
+    }
+
+    uint32_t id = (uint32_t)set->count++;
+    set->parent[id] = id;
+    set->size[id] = 1;
+    if (out_id)
+        *out_id = id;
+    return true;
+}
+
+uint32_t disjoint_set_find(disjoint_set_t *set, uint32_t id) {
+    if (!set || id >= set->count)
+        return id;
+
+    // Path halving: point every other node on the path at its grandparent
+    while (set->parent[id] != id) {
+        set->parent[id] = set->parent[set->parent[id]];
+        id = set->parent[id];
+    }
+    return id;
+}
+
+uint32_t disjoint_set_union(disjoint_set_t *set, uint32_t a, uint32_t b) {
+    uint32_t root_a = disjoint_set_find(set, a);
+    uint32_t root_b = disjoint_set_find(set, b);
+    if (!set || root_a == root_b || root_a >= set->count ||
+        root_b >= set->count)
+        return root_a;
+
+    if (set->size[root_a] < set->size[root_b]) {
+        uint32_t swap = root_a;
+        root_a = root_b;
+        root_b = swap;
+    }
+    set->parent[root_b] = root_a;
+    set->size[root_a] += set->size[root_b];
+    return root_a;
+}
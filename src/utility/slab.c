@@ -0,0 +1,117 @@
+#include "utility/slab.h"
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct slab_chunk {
+    slab_chunk_t *next;
+    alignas(max_align_t) unsigned char data[];
+};
+
+slab_t *slab_create(size_t object_size, size_t objects_per_chunk) {
+    if (object_size == 0 || objects_per_chunk == 0)
+        return NULL;
+
+    slab_t *slab = malloc(sizeof(slab_t));
+    if (!slab) {
+        fprintf(stderr, "Out of memory!\n");
+        return NULL;
+    }
+
+    // Every slot must be able to hold the free-list link and keep the next
+    // slot aligned
+    size_t align = alignof(max_align_t);
+    if (object_size < sizeof(void *))
+        object_size = sizeof(void *);
+    slab->object_size = (object_size + align - 1) / align * align;
+    slab->objects_per_chunk = objects_per_chunk;
+    slab->chunks = NULL;
+    slab->chunk_capacity = 0;
+    slab->chunk_used = 0; // Full, so the first alloc takes a chunk
+    slab->free_list = NULL;
+    slab->live_count = 0;
+    return slab;
+}
+
+// Pushes a new head chunk holding 'capacity' objects
+static bool slab_add_chunk(slab_t *slab, size_t capacity) {
+    slab_chunk_t *chunk =
+      malloc(sizeof(slab_chunk_t) + slab->object_size * capacity);
+    if (!chunk) {
+        fprintf(stderr, "Out of memory!\n");
+        return false;
+    }
+    chunk->next = slab->chunks;
+    slab->chunks = chunk;
+    slab->chunk_capacity = capacity;
+    slab->chunk_used = 0;
+    return true;
+}
+
+void *slab_alloc(slab_t *slab) {
+    if (!slab)
+        return NULL;
+
+    void *object;
+    if (slab->free_list) {
+        object = slab->free_list;
+        slab->free_list = *(void **)object;
+    } else {
+        if (slab->chunk_used == slab->chunk_capacity &&
+            !slab_add_chunk(slab, slab->objects_per_chunk))
+            return NULL;
+        object = slab->chunks->data + slab->object_size * slab->chunk_used++;
+    }
+
+    slab->live_count++;
+    return object;
+}
+
+bool slab_reserve(slab_t *slab, size_t count) {
+    if (!slab)
+        return false;
+    if (slab->chunk_capacity - slab->chunk_used >= count)
+        return true;
+    return slab_add_chunk(slab, count > slab->objects_per_chunk
+                                  ? count
+                                  : slab->objects_per_chunk);
+}
+
+void slab_release(slab_t *slab, void *object) {
+    if (!slab || !object)
+        return;
+    *(void **)object = slab->free_list;
+    slab->free_list = object;
+    slab->live_count--;
+}
+
+void slab_reset(slab_t *slab) {
+    if (!slab)
+        return;
+
+    // Keep the newest chunk so a refill does not go straight back to malloc
+    if (slab->chunks) {
+        slab_chunk_t *chunk = slab->chunks->next;
+        while (chunk) {
+            slab_chunk_t *next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+        slab->chunks->next = NULL;
+        slab->chunk_used = 0;
+    }
+    slab->free_list = NULL;
+    slab->live_count = 0;
+}
+
+void slab_destroy(slab_t *slab) {
+    if (!slab)
+        return;
+    slab_chunk_t *chunk = slab->chunks;
+    while (chunk) {
+        slab_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(slab);
+}
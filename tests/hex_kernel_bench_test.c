@@ -0,0 +1,137 @@
+// Times the header-only hex kernels, which work on a compact hex_coord_t,
+// against the grid_geometry_* vtable path on tagged grid_cell_t values, for
+// neighbors, distance and apply_offset. Both paths must produce the same
+// cells; the benchmark reports nanoseconds per cell and the speedup.
+#include "grid/grid_geometry.h"
+#include "grid/grid_types.h"
+#include "grid/hex_kernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM_CELLS 4096 // Fits in cache, so the calls themselves are timed
+#define ROUNDS 2000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static grid_cell_t random_cell(int radius) {
+    int q = rand() % (2 * radius + 1) - radius;
+    int r = rand() % (2 * radius + 1) - radius;
+    grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+    cell.coord.hex.q = q;
+    cell.coord.hex.r = r;
+    cell.coord.hex.s = -q - r;
+    return cell;
+}
+
+// Order-dependent fold of a cell into a checksum
+static unsigned long mix_hex(unsigned long sum, hex_coord_t h) {
+    return sum * 31 + h.q * 7 + h.r * 3 + h.s;
+}
+
+static unsigned long neighbors_vtable(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    grid_cell_t neighbors[6];
+    for (int i = 0; i < NUM_CELLS; i++) {
+        grid_geometry_get_all_neighbors(GRID_TYPE_HEXAGON, cells[i], neighbors);
+        for (int d = 0; d < 6; d++)
+            sum = mix_hex(sum, neighbors[d].coord.hex);
+    }
+    return sum;
+}
+
+static unsigned long neighbors_kernel(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        for (int d = 0; d < 6; d++)
+            sum = mix_hex(sum, hex_kernel_neighbor(cells[i].coord.hex, d));
+    }
+    return sum;
+}
+
+static unsigned long distance_vtable(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    for (int i = 0; i < NUM_CELLS; i++)
+        sum += grid_geometry_distance(GRID_TYPE_HEXAGON, cells[i],
+                                      cells[(i + 1) % NUM_CELLS]);
+    return sum;
+}
+
+static unsigned long distance_kernel(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    for (int i = 0; i < NUM_CELLS; i++)
+        sum += hex_kernel_distance(cells[i].coord.hex,
+                                   cells[(i + 1) % NUM_CELLS].coord.hex);
+    return sum;
+}
+
+static unsigned long offset_vtable(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        grid_cell_t moved = grid_geometry_apply_offset(
+          GRID_TYPE_HEXAGON, cells[i], cells[(i + 1) % NUM_CELLS]);
+        sum = mix_hex(sum, moved.coord.hex);
+    }
+    return sum;
+}
+
+static unsigned long offset_kernel(const grid_cell_t *cells) {
+    unsigned long sum = 0;
+    for (int i = 0; i < NUM_CELLS; i++) {
+        hex_coord_t moved = hex_kernel_apply(
+          cells[i].coord.hex, cells[(i + 1) % NUM_CELLS].coord.hex);
+        sum = mix_hex(sum, moved);
+    }
+    return sum;
+}
+
+// Runs 'fn' ROUNDS times; returns nanoseconds per cell and stores the folded
+// checksums in 'out_sum'
+static double time_op(unsigned long (*fn)(const grid_cell_t *),
+                      const grid_cell_t *cells, unsigned long *out_sum) {
+    unsigned long sum = 0;
+    double start = now_seconds();
+    for (int round = 0; round < ROUNDS; round++)
+        sum ^= fn(cells) + (unsigned long)round;
+    double elapsed = now_seconds() - start;
+    *out_sum = sum;
+    return elapsed * 1e9 / ((double)ROUNDS * NUM_CELLS);
+}
+
+int main(void) {
+    static grid_cell_t cells[NUM_CELLS];
+    srand(1);
+    for (int i = 0; i < NUM_CELLS; i++)
+        cells[i] = random_cell(1000);
+
+    struct {
+        const char *name;
+        unsigned long (*vtable)(const grid_cell_t *);
+        unsigned long (*kernel)(const grid_cell_t *);
+    } ops[] = {
+      {"all_neighbors", neighbors_vtable, neighbors_kernel},
+      {"distance", distance_vtable, distance_kernel},
+      {"apply_offset", offset_vtable, offset_kernel},
+    };
+
+    printf("%-14s %12s %12s %8s\n", "operation", "vtable ns", "kernel ns",
+           "speedup");
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        unsigned long vtable_sum, kernel_sum;
+        double vtable_ns = time_op(ops[i].vtable, cells, &vtable_sum);
+        double kernel_ns = time_op(ops[i].kernel, cells, &kernel_sum);
+        printf("%-14s %12.2f %12.2f %7.1fx\n", ops[i].name, vtable_ns,
+               kernel_ns, vtable_ns / kernel_ns);
+        if (vtable_sum != kernel_sum) {
+            printf("FAIL: %s results differ between the two paths\n",
+                   ops[i].name);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
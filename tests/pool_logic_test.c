@@ -0,0 +1,411 @@
+// Randomized check of the pool bookkeeping. A main board goes through random
+// single-tile placements, removals, color cycles, rotated piece placements
+// and pool modifier changes. After every step, each pool is compared against
+// a brute-force recount from the board's tiles: its connected component,
+// edge counts, diameter, frontier and adjacency, plus the leaderboard heap.
+#include "game/board.h"
+#include "grid/grid_geometry.h"
+#include "grid/hex_kernels.h"
+#include "tile/pool.h"
+#include "tile/pool_manager.h"
+#include "tile/tile_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BOARD_RADIUS 6
+#define STEPS 1500
+#define MAX_POOLS 512
+
+static int failures = 0;
+static const char *current_step = "";
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            failures++;                                                       \
+            printf("FAIL (%s) %s:%d: ", current_step, __FILE__, __LINE__);    \
+            printf(__VA_ARGS__);                                              \
+            printf("\n");                                                     \
+        }                                                                     \
+    } while (0)
+
+typedef struct {
+    tile_t **items;
+    size_t count;
+    size_t capacity;
+} tile_list_t;
+
+static void tile_list_push(tile_list_t *list, tile_t *tile) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 64;
+        list->items = realloc(list->items, list->capacity * sizeof(tile_t *));
+        if (!list->items) {
+            fprintf(stderr, "Out of memory!\n");
+            exit(1);
+        }
+    }
+    list->items[list->count++] = tile;
+}
+
+static void collect_tile(tile_t *tile, void *user_data) {
+    tile_list_push(user_data, tile);
+}
+
+static pool_t *pool_of(board_t *board, tile_t *tile) {
+    uint32_t id = pool_manager_tile_pool_id(board->pools, tile);
+    return id ? pool_manager_get_pool(board->pools, (int)id) : NULL;
+}
+
+static grid_cell_t random_cell(int radius) {
+    for (;;) {
+        int q = rand() % (2 * radius + 1) - radius;
+        int r = rand() % (2 * radius + 1) - radius;
+        if (abs(q + r) > radius)
+            continue;
+        grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+        cell.coord.hex.q = q;
+        cell.coord.hex.r = r;
+        cell.coord.hex.s = -q - r;
+        return cell;
+    }
+}
+
+// --- Brute-force recounts ---
+
+// Same-type component of 'start', by flood fill over the board's tiles
+static void collect_component(board_t *board, tile_t *start,
+                              tile_map_t *visited, tile_list_t *out) {
+    tile_list_t stack = {0};
+    tile_list_push(&stack, start);
+    tile_map_add(visited, start);
+    while (stack.count > 0) {
+        tile_t *tile = stack.items[--stack.count];
+        tile_list_push(out, tile);
+        grid_cell_t neighbors[6];
+        hex_kernel_all_neighbors(tile->cell.coord.hex, neighbors);
+        for (int d = 0; d < 6; d++) {
+            tile_t *neighbor = board_tile_at_cell(board, neighbors[d]);
+            if (neighbor && neighbor->data.type == start->data.type &&
+                !tile_map_contains(visited, neighbor->cell)) {
+                tile_map_add(visited, neighbor);
+                tile_list_push(&stack, neighbor);
+            }
+        }
+    }
+    free(stack.items);
+}
+
+static void check_pool_geometry(pool_t *pool, const tile_list_t *component) {
+    // Edges: each side of a tile is internal (shared with the pool) or
+    // external
+    int internal_sides = 0;
+    int external = 0;
+    for (size_t i = 0; i < component->count; i++) {
+        grid_cell_t neighbors[6];
+        hex_kernel_all_neighbors(component->items[i]->cell.coord.hex,
+                                 neighbors);
+        for (int d = 0; d < 6; d++) {
+            if (tile_map_contains(pool->tiles, neighbors[d]))
+                internal_sides++;
+            else
+                external++;
+        }
+    }
+    CHECK(pool->internal_edge_count == internal_sides / 2,
+          "pool %d internal edges %d, expected %d", pool->id,
+          pool->internal_edge_count, internal_sides / 2);
+    CHECK(pool->edge_count == external, "pool %d edges %d, expected %d",
+          pool->id, pool->edge_count, external);
+
+    // Diameter: farthest pair
+    int diameter = 0;
+    for (size_t i = 0; i < component->count; i++) {
+        for (size_t j = i + 1; j < component->count; j++) {
+            int distance =
+              hex_kernel_distance(component->items[i]->cell.coord.hex,
+                                  component->items[j]->cell.coord.hex);
+            if (distance > diameter)
+                diameter = distance;
+        }
+    }
+    CHECK(pool_calculate_diameter(pool, GRID_TYPE_HEXAGON) == diameter,
+          "pool %d diameter %d, expected %d", pool->id,
+          pool_calculate_diameter(pool, GRID_TYPE_HEXAGON), diameter);
+
+    // Frontier: every outside cell next to the pool, with the number of pool
+    // tiles it touches
+    int frontier_size = 0;
+    tile_map_t *seen = tile_map_create();
+    tile_list_t markers = {0};
+    for (size_t i = 0; i < component->count; i++) {
+        grid_cell_t neighbors[6];
+        hex_kernel_all_neighbors(component->items[i]->cell.coord.hex,
+                                 neighbors);
+        for (int d = 0; d < 6; d++) {
+            grid_cell_t cell = neighbors[d];
+            if (tile_map_contains(pool->tiles, cell) ||
+                tile_map_contains(seen, cell))
+                continue;
+            tile_t *marker = calloc(1, sizeof(tile_t));
+            marker->cell = cell;
+            tile_map_add(seen, marker);
+            tile_list_push(&markers, marker);
+            frontier_size++;
+
+            int touching = 0;
+            grid_cell_t around[6];
+            hex_kernel_all_neighbors(cell.coord.hex, around);
+            for (int e = 0; e < 6; e++)
+                touching += tile_map_contains(pool->tiles, around[e]);
+            tile_map_key_t key = tile_map_key_from_cell(cell);
+            pool_frontier_entry_t *entry = NULL;
+            HASH_FIND(hh, pool->frontier, &key, sizeof(key), entry);
+            CHECK(entry && entry->count == touching,
+                  "pool %d frontier cell (%d, %d) count %d, expected %d",
+                  pool->id, cell.coord.hex.q, cell.coord.hex.r,
+                  entry ? entry->count : -1, touching);
+        }
+    }
+    CHECK(pool_get_neighbor_cells(pool, NULL) == frontier_size,
+          "pool %d frontier size %d, expected %d", pool->id,
+          pool_get_neighbor_cells(pool, NULL), frontier_size);
+    tile_map_free(seen);
+    for (size_t i = 0; i < markers.count; i++)
+        free(markers.items[i]);
+    free(markers.items);
+}
+
+static void check_pool_adjacency(board_t *board, pool_t *pool) {
+    pool_t *neighbors[MAX_POOLS];
+    int shared[MAX_POOLS];
+    int count = 0;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(pool->tiles, tile, iter) {
+        grid_cell_t cells[6];
+        hex_kernel_all_neighbors(tile->cell.coord.hex, cells);
+        for (int d = 0; d < 6; d++) {
+            tile_t *other = board_tile_at_cell(board, cells[d]);
+            pool_t *other_pool = other ? pool_of(board, other) : NULL;
+            if (!other_pool || other_pool == pool)
+                continue;
+            int k = 0;
+            while (k < count && neighbors[k] != other_pool)
+                k++;
+            if (k == count) {
+                neighbors[count] = other_pool;
+                shared[count++] = 0;
+            }
+            shared[k]++;
+        }
+    }
+
+    size_t degree = pool_get_adjacent_pools(pool, TILE_UNDEFINED, NULL, 0);
+    CHECK(degree == (size_t)count, "pool %d touches %zu pools, expected %d",
+          pool->id, degree, count);
+    for (int k = 0; k < count; k++) {
+        CHECK(pool_adjacency_shared_edges(pool, neighbors[k]) == shared[k],
+              "pool %d shares %d edges with pool %d, expected %d", pool->id,
+              pool_adjacency_shared_edges(pool, neighbors[k]),
+              neighbors[k]->id, shared[k]);
+    }
+}
+
+static bool ranks_before(const pool_t *a, const pool_t *b) {
+    if (a->score != b->score)
+        return a->score > b->score;
+    return a->id < b->id;
+}
+
+static void check_leaderboard(pool_manager_t *manager) {
+    size_t size = kv_size(manager->leaderboard);
+    CHECK(size == manager->num_pools, "leaderboard holds %zu of %zu pools",
+          size, manager->num_pools);
+
+    for (size_t i = 0; i < size; i++) {
+        pool_t *pool = kv_A(manager->leaderboard, i);
+        float expected = (float)pool_tile_score(pool) * pool->modifier;
+        CHECK(pool->leaderboard_index == i, "pool %d slot %zu, recorded %zu",
+              pool->id, i, pool->leaderboard_index);
+        CHECK(!pool->score_dirty && pool->score == expected,
+              "pool %d score %f, expected %f", pool->id, pool->score,
+              expected);
+        if (i > 0) {
+            pool_t *parent = kv_A(manager->leaderboard, (i - 1) / 2);
+            CHECK(!ranks_before(pool, parent),
+                  "pool %d ranks above its heap parent %d", pool->id,
+                  parent->id);
+        }
+    }
+
+    // The best-first walk must agree with a full sort
+    pool_t *sorted[MAX_POOLS];
+    size_t count = size < MAX_POOLS ? size : MAX_POOLS;
+    for (size_t i = 0; i < count; i++)
+        sorted[i] = kv_A(manager->leaderboard, i);
+    for (size_t i = 1; i < count; i++) {
+        pool_t *pool = sorted[i];
+        size_t j = i;
+        for (; j > 0 && ranks_before(pool, sorted[j - 1]); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = pool;
+    }
+    pool_t *top[8];
+    size_t top_count = pool_manager_top_pools(manager, top, 8);
+    if (size <= MAX_POOLS) {
+        for (size_t i = 0; i < top_count; i++)
+            CHECK(top[i] == sorted[i], "top pool %zu is %d, expected %d", i,
+                  top[i]->id, sorted[i]->id);
+    }
+}
+
+static void check_board(board_t *board) {
+    tile_list_t tiles = {0};
+    tile_map_foreach_tile(board->tiles, collect_tile, &tiles);
+
+    tile_map_t *visited = tile_map_create();
+    size_t components = 0;
+    for (size_t i = 0; i < tiles.count; i++) {
+        if (tile_map_contains(visited, tiles.items[i]->cell))
+            continue;
+        tile_list_t component = {0};
+        collect_component(board, tiles.items[i], visited, &component);
+
+        pool_t *pool = pool_of(board, component.items[0]);
+        if (component.count == 1) {
+            CHECK(pool == NULL, "single tile at (%d, %d) has pool %d",
+                  component.items[0]->cell.coord.hex.q,
+                  component.items[0]->cell.coord.hex.r, pool ? pool->id : 0);
+        } else {
+            components++;
+            CHECK(pool != NULL, "component of %zu tiles has no pool",
+                  component.count);
+        }
+        if (pool && component.count > 1) {
+            CHECK(tile_map_size(pool->tiles) == (int)component.count,
+                  "pool %d has %d tiles, component has %zu", pool->id,
+                  tile_map_size(pool->tiles), component.count);
+            for (size_t k = 0; k < component.count; k++) {
+                CHECK(pool_of(board, component.items[k]) == pool,
+                      "component split across pools");
+            }
+            check_pool_geometry(pool, &component);
+            check_pool_adjacency(board, pool);
+        }
+        free(component.items);
+    }
+    CHECK(board->pools->num_pools == components, "%zu pools for %zu components",
+          board->pools->num_pools, components);
+    check_leaderboard(board->pools);
+
+    tile_map_free(visited);
+    free(tiles.items);
+}
+
+// --- Random operations ---
+
+static tile_t *random_board_tile(board_t *board) {
+    tile_list_t tiles = {0};
+    tile_map_foreach_tile(board->tiles, collect_tile, &tiles);
+    tile_t *tile = tiles.count ? tiles.items[rand() % tiles.count] : NULL;
+    free(tiles.items);
+    return tile;
+}
+
+static void step_add(board_t *board, tile_list_t *owned) {
+    grid_cell_t cell = random_cell(board->radius);
+    if (board_tile_at_cell(board, cell))
+        return;
+    tile_type_t type = (tile_type_t)(TILE_MAGENTA + rand() % 3);
+    tile_t *tile = tile_create_ptr(cell, tile_data_create(type, 1, 1.0f));
+    tile_list_push(owned, tile);
+    CHECK(board_add_tile(board, tile), "board_add_tile failed");
+}
+
+static void step_remove(board_t *board) {
+    tile_t *tile = random_board_tile(board);
+    if (tile)
+        remove_tile(board, tile);
+}
+
+static void step_cycle(board_t *board) {
+    tile_t *tile = random_board_tile(board);
+    if (tile)
+        cycle_tile_type(board, tile);
+}
+
+// Fills a small piece, checks it, rotates it about a nearby pivot, checks it
+// again and merges it into the board at a random cell
+static void step_place_piece(board_t *board) {
+    board_t *piece =
+      board_create(GRID_TYPE_HEXAGON, 3, BOARD_TYPE_INVENTORY);
+    board_fill(piece, 1, BOARD_TYPE_INVENTORY);
+    current_step = "piece";
+    check_board(piece);
+
+    grid_cell_t pivot = random_cell(1);
+    board_rotate(piece, pivot, rand() % 12 - 6);
+    current_step = "rotate";
+    check_board(piece);
+
+    grid_cell_t target = random_cell(board->radius);
+    merge_boards(board, piece, target,
+                 grid_geometry_get_origin(GRID_TYPE_HEXAGON));
+    free_board(piece);
+}
+
+static void step_modifier(board_t *board) {
+    tile_t *tile = random_board_tile(board);
+    pool_t *pool = tile ? pool_of(board, tile) : NULL;
+    if (!pool)
+        return;
+    static const float modifiers[] = {0.5f, 1.0f, 2.0f, 3.0f};
+    if (rand() % 2)
+        pool_manager_set_pool_modifier(board->pools, pool,
+                                       modifiers[rand() % 4]);
+    else
+        pool_manager_add_pool_modifier(board->pools, pool, 0.5f);
+}
+
+int main(int argc, char **argv) {
+    unsigned seed = argc > 1 ? (unsigned)atoi(argv[1]) : 1;
+    srand(seed);
+
+    board_t *board =
+      board_create(GRID_TYPE_HEXAGON, BOARD_RADIUS, BOARD_TYPE_MAIN);
+    tile_list_t owned = {0};
+    for (int step = 0; step < STEPS && failures == 0; step++) {
+        switch (rand() % 6) {
+        case 0:
+        case 1:
+            current_step = "add";
+            step_add(board, &owned);
+            break;
+        case 2:
+            current_step = "remove";
+            step_remove(board);
+            break;
+        case 3:
+            current_step = "cycle";
+            step_cycle(board);
+            break;
+        case 4:
+            step_place_piece(board);
+            current_step = "place";
+            break;
+        default:
+            current_step = "modifier";
+            step_modifier(board);
+            break;
+        }
+        check_board(board);
+    }
+
+    printf("seed %u: %d tiles, %zu pools, %d failures\n", seed,
+           tile_map_size(board->tiles), board->pools->num_pools, failures);
+    free_board(board);
+    for (size_t i = 0; i < owned.count; i++)
+        free(owned.items[i]);
+    free(owned.items);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+// Times a neighbor-counting pass, the access pattern of pool assignment and
+// edge counting, over a ~1M-tile board stored four ways: a hash map in
+// random insertion order, the same map after tile_map_sort_spatial, and
+// dense maps in row-major and Morton order. Every layout holds the same
+// tiles, so the neighbor counts must match and only the wall time differs.
+#include "grid/grid_types.h"
+#include "grid/hex_kernels.h"
+#include "tile/tile.h"
+#include "tile/tile_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BOARD_RADIUS 577 // 3 * 577 * 578 + 1 = 1000519 tiles
+#define PASSES 3
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// For every tile, looks up its six neighbors and counts those of the same
+// type; returns the total
+static long count_same_type_neighbors(const tile_map_t *map) {
+    long total = 0;
+    tile_map_iter_t iter;
+    tile_t *tile;
+    TILE_MAP_ITER(map, tile, iter) {
+        grid_cell_t neighbors[6];
+        hex_kernel_all_neighbors(tile->cell.coord.hex, neighbors);
+        for (int i = 0; i < 6; i++) {
+            tile_t *neighbor = tile_map_get(map, neighbors[i]);
+            if (neighbor && neighbor->data.type == tile->data.type)
+                total++;
+        }
+    }
+    return total;
+}
+
+// Best wall time of PASSES passes, in milliseconds; the count goes to
+// 'out_total'
+static double bench_layout(const tile_map_t *map, long *out_total) {
+    double best = 0.0;
+    for (int pass = 0; pass < PASSES; pass++) {
+        double start = now_seconds();
+        *out_total = count_same_type_neighbors(map);
+        double elapsed = (now_seconds() - start) * 1e3;
+        if (pass == 0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+int main(void) {
+    int radius = BOARD_RADIUS;
+    size_t capacity = (size_t)(3 * radius * (radius + 1) + 1);
+    tile_t *tiles = malloc(capacity * sizeof(tile_t));
+    tile_t **shuffled = malloc(capacity * sizeof(tile_t *));
+    if (!tiles || !shuffled) {
+        fprintf(stderr, "Out of memory!\n");
+        return 1;
+    }
+
+    // Tiles live in one array in row order, as a board fill creates them
+    srand(1);
+    size_t count = 0;
+    for (int r = -radius; r <= radius; r++) {
+        for (int q = -radius; q <= radius; q++) {
+            int s = -q - r;
+            if (abs(s) > radius)
+                continue;
+            grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+            cell.coord.hex.q = q;
+            cell.coord.hex.r = r;
+            cell.coord.hex.s = s;
+            tile_type_t type = (tile_type_t)(TILE_MAGENTA + rand() % 4);
+            tiles[count] = (tile_t){.cell = cell,
+                                     .data = tile_data_create(type, 1, 1.0f)};
+            shuffled[count] = &tiles[count];
+            count++;
+        }
+    }
+    for (size_t i = count; i > 1; i--) {
+        size_t j = (size_t)rand() % i;
+        tile_t *swap = shuffled[i - 1];
+        shuffled[i - 1] = shuffled[j];
+        shuffled[j] = swap;
+    }
+
+    tile_map_t *hash_random = tile_map_create();
+    tile_map_t *hash_sorted = tile_map_create();
+    tile_map_t *dense_rows =
+      tile_map_create_dense_ordered(radius, TILE_MAP_ORDER_ROWS);
+    tile_map_t *dense_morton =
+      tile_map_create_dense_ordered(radius, TILE_MAP_ORDER_MORTON);
+    if (!hash_random || !hash_sorted || !dense_rows || !dense_morton ||
+        !tile_map_add_bulk(hash_random, shuffled, count) ||
+        !tile_map_add_bulk(hash_sorted, shuffled, count) ||
+        !tile_map_add_bulk(dense_rows, shuffled, count) ||
+        !tile_map_add_bulk(dense_morton, shuffled, count)) {
+        fprintf(stderr, "Out of memory!\n");
+        return 1;
+    }
+    tile_map_sort_spatial(hash_sorted);
+
+    struct {
+        const char *name;
+        const tile_map_t *map;
+    } layouts[] = {
+      {"hash, insertion order", hash_random},
+      {"hash, Morton sorted", hash_sorted},
+      {"dense, row-major", dense_rows},
+      {"dense, Morton", dense_morton},
+    };
+    size_t num_layouts = sizeof(layouts) / sizeof(layouts[0]);
+
+    printf("%zu tiles, best of %d passes\n", count, PASSES);
+    printf("%-24s %10s\n", "layout", "ms/pass");
+    long expected = -1;
+    int failures = 0;
+    for (size_t i = 0; i < num_layouts; i++) {
+        long total;
+        double ms = bench_layout(layouts[i].map, &total);
+        printf("%-24s %10.1f\n", layouts[i].name, ms);
+        if (expected < 0) {
+            expected = total;
+        } else if (total != expected) {
+            printf("FAIL: %s counted %ld neighbors, expected %ld\n",
+                   layouts[i].name, total, expected);
+            failures++;
+        }
+    }
+
+    for (size_t i = 0; i < num_layouts; i++)
+        tile_map_free((tile_map_t *)layouts[i].map);
+    free(shuffled);
+    free(tiles);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Times tile_map_get on hash maps of 100 to 1M tiles. Lookups go through the
+// packed cell key, so the cost per lookup should stay flat as the map grows;
+// a linear scan would grow 10000x over the same range.
+#include "grid/grid_types.h"
+#include "tile/tile.h"
+#include "tile/tile_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define LOOKUPS 2000000
+// Allowed growth of the per-lookup cost from the smallest map to the largest.
+// Cache misses on the big tables account for a few times; anything near the
+// size ratio means lookups stopped being O(1).
+#define MAX_COST_GROWTH 16.0
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Fills 'cells' with the first 'count' cells of a hexagon around the origin,
+// ring by ring
+static void make_cells(grid_cell_t *cells, size_t count) {
+    size_t n = 0;
+    for (int radius = 0; n < count; radius++) {
+        for (int q = -radius; q <= radius && n < count; q++) {
+            for (int r = -radius; r <= radius && n < count; r++) {
+                int s = -q - r;
+                int distance = abs(q) > abs(r) ? abs(q) : abs(r);
+                if (abs(s) > distance)
+                    distance = abs(s);
+                if (distance != radius)
+                    continue;
+                grid_cell_t cell = {.type = GRID_TYPE_HEXAGON};
+                cell.coord.hex.q = q;
+                cell.coord.hex.r = r;
+                cell.coord.hex.s = s;
+                cells[n++] = cell;
+            }
+        }
+    }
+}
+
+// Returns the average nanoseconds per lookup, or a negative value if a
+// lookup missed
+static double bench_lookups(const grid_cell_t *cells, size_t count) {
+    tile_map_t *map = tile_map_create();
+    tile_t **tiles = malloc(count * sizeof(tile_t *));
+    size_t *order = malloc(LOOKUPS * sizeof(size_t));
+    if (!map || !tiles || !order) {
+        fprintf(stderr, "Out of memory!\n");
+        exit(1);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        tiles[i] =
+          tile_create_ptr(cells[i], tile_data_create(TILE_CYAN, 1, 1.0f));
+        tile_map_add(map, tiles[i]);
+    }
+    // Random probe order, so the big maps are not read sequentially
+    for (size_t i = 0; i < LOOKUPS; i++)
+        order[i] = (size_t)rand() % count;
+
+    size_t found = 0;
+    double start = now_seconds();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        if (tile_map_get(map, cells[order[i]]) == tiles[order[i]])
+            found++;
+    }
+    double elapsed = now_seconds() - start;
+
+    tile_map_free(map);
+    for (size_t i = 0; i < count; i++)
+        free(tiles[i]);
+    free(tiles);
+    free(order);
+    return found == LOOKUPS ? elapsed * 1e9 / LOOKUPS : -1.0;
+}
+
+int main(void) {
+    static const size_t sizes[] = {100, 1000, 10000, 100000, 1000000};
+    size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    size_t max_size = sizes[num_sizes - 1];
+
+    grid_cell_t *cells = malloc(max_size * sizeof(grid_cell_t));
+    if (!cells) {
+        fprintf(stderr, "Out of memory!\n");
+        return 1;
+    }
+    make_cells(cells, max_size);
+    srand(1);
+
+    printf("%10s %12s\n", "tiles", "ns/lookup");
+    double first = 0.0;
+    int failures = 0;
+    for (size_t i = 0; i < num_sizes; i++) {
+        double cost = bench_lookups(cells, sizes[i]);
+        if (cost < 0.0) {
+            printf("FAIL: lookup missed on %zu tiles\n", sizes[i]);
+            failures++;
+            continue;
+        }
+        printf("%10zu %12.1f\n", sizes[i], cost);
+        if (i == 0)
+            first = cost;
+        else if (cost > first * MAX_COST_GROWTH) {
+            printf("FAIL: %zu tiles cost %.1fx the %zu-tile lookup\n", sizes[i],
+                   cost / first, sizes[0]);
+            failures++;
+        }
+    }
+
+    free(cells);
+    return failures ? 1 : 0;
+}